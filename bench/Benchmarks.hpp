@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Profiler.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Result of a single micro-benchmark.
+struct BenchmarkResult {
+  std::string name;
+
+  /// \brief Number of items processed by each repetition, such as a number of
+  /// games or a number of table rows.
+  std::size_t items{0};
+
+  std::size_t repetitions{0};
+
+  /// \brief Fastest, median, and mean wall time of a repetition in seconds.
+  double minimum_time{0.0};
+
+  double median_time{0.0};
+
+  double mean_time{0.0};
+
+  /// \brief Number of heap allocations performed by the fastest repetition.
+  std::size_t allocations{0};
+};
+
+/// \brief Discards everything printed to the console from its construction to
+/// its destruction.
+class SilentConsole {
+public:
+  SilentConsole() noexcept : console_(std::cout.rdbuf(&discard_)) {}
+
+  SilentConsole(const SilentConsole&) = delete;
+
+  SilentConsole& operator=(const SilentConsole&) = delete;
+
+  ~SilentConsole() noexcept {
+    std::cout.rdbuf(console_);
+  }
+
+private:
+  /// \brief Stream buffer that discards everything written to it.
+  class DiscardBuffer : public std::streambuf {
+  protected:
+    int overflow(const int character) override {
+      return character;
+    }
+  };
+
+  DiscardBuffer discard_;
+
+  std::streambuf* console_;
+
+};  // class SilentConsole
+
+/// \brief Runner of micro-benchmarks. Each benchmark is repeated a number of
+/// times and its wall time and heap allocations are recorded.
+/// \details Console messages printed by the benchmarked code are discarded
+/// while the benchmarks run, such that the results can be printed in a
+/// machine-readable format.
+class Benchmarks {
+public:
+  Benchmarks(const std::size_t repetitions) noexcept
+    : repetitions_(std::max(repetitions, static_cast<std::size_t>(1))) {
+    CountAllocations.store(true, std::memory_order_relaxed);
+  }
+
+  const std::vector<BenchmarkResult>& results() const noexcept {
+    return results_;
+  }
+
+  /// \brief Runs a benchmark that processes a given number of items.
+  void run(const std::string& name, const std::size_t items,
+           const std::function<void()>& function) {
+    std::vector<double> times;
+    std::size_t allocations{std::numeric_limits<std::size_t>::max()};
+    for (std::size_t repetition = 0; repetition < repetitions_; ++repetition) {
+      const SilentConsole silent_console;
+      const std::size_t start_allocations{
+          NumberOfAllocations.load(std::memory_order_relaxed)};
+      const std::chrono::steady_clock::time_point start{
+          std::chrono::steady_clock::now()};
+      function();
+      const std::chrono::steady_clock::time_point finish{
+          std::chrono::steady_clock::now()};
+      const std::size_t finish_allocations{
+          NumberOfAllocations.load(std::memory_order_relaxed)};
+      times.push_back(std::chrono::duration<double>(finish - start).count());
+      if (times.back() <= *std::min_element(times.cbegin(), times.cend())) {
+        allocations = finish_allocations - start_allocations;
+      }
+    }
+    std::sort(times.begin(), times.end());
+    results_.push_back(
+        {name, items, times.size(), times.front(), times[times.size() / 2],
+         std::accumulate(times.cbegin(), times.cend(), 0.0) / times.size(),
+         allocations});
+    std::cerr << "Ran the '" << name << "' benchmark." << std::endl;
+  }
+
+  /// \brief Results as a JSON document.
+  std::string print_as_json() const noexcept {
+    std::stringstream stream;
+    stream << "{" << std::endl << "  \"benchmarks\": [";
+    for (std::size_t index = 0; index < results_.size(); ++index) {
+      const BenchmarkResult& result{results_[index]};
+      stream << (index == 0 ? "" : ",") << std::endl
+             << "    {" << std::endl
+             << "      \"name\": \"" << result.name << "\"," << std::endl
+             << "      \"items\": " << result.items << "," << std::endl
+             << "      \"repetitions\": " << result.repetitions << ","
+             << std::endl
+             << "      \"minimum_seconds\": "
+             << real_number_to_string(result.minimum_time, 9) << ","
+             << std::endl
+             << "      \"median_seconds\": "
+             << real_number_to_string(result.median_time, 9) << ","
+             << std::endl
+             << "      \"mean_seconds\": "
+             << real_number_to_string(result.mean_time, 9) << "," << std::endl
+             << "      \"nanoseconds_per_item\": "
+             << real_number_to_string(nanoseconds_per_item(result), 1) << ","
+             << std::endl
+             << "      \"allocations\": " << result.allocations << std::endl
+             << "    }";
+    }
+    stream << std::endl << "  ]" << std::endl << "}";
+    return stream.str();
+  }
+
+  /// \brief Results as comma-separated values with a header row.
+  std::string print_as_csv() const noexcept {
+    std::stringstream stream;
+    stream << "name,items,repetitions,minimum_seconds,median_seconds,"
+              "mean_seconds,nanoseconds_per_item,allocations";
+    for (const BenchmarkResult& result : results_) {
+      stream << std::endl
+             << result.name << "," << result.items << ","
+             << result.repetitions << ","
+             << real_number_to_string(result.minimum_time, 9) << ","
+             << real_number_to_string(result.median_time, 9) << ","
+             << real_number_to_string(result.mean_time, 9) << ","
+             << real_number_to_string(nanoseconds_per_item(result), 1) << ","
+             << result.allocations;
+    }
+    return stream.str();
+  }
+
+private:
+  std::size_t repetitions_;
+
+  std::vector<BenchmarkResult> results_;
+
+  static double nanoseconds_per_item(const BenchmarkResult& result) noexcept {
+    return result.minimum_time * 1.0e9
+           / static_cast<double>(std::max(result.items,
+                                          static_cast<std::size_t>(1)));
+  }
+
+};  // class Benchmarks
+
+}  // namespace TI4Echelon
@@ -0,0 +1,260 @@
+#include <unistd.h>
+
+#include "Benchmarks.hpp"
+#include "GamesGenerator.hpp"
+#include "Leaderboard.hpp"
+
+namespace {
+
+const std::string Usage{
+    "Usage: ti4-echelon-bench [--games <number>] [--players <number>] "
+    "[--repetitions <number>] [--seed <number>] [--format json|csv] "
+    "[--output <path>]"};
+
+/// \brief Settings of the micro-benchmarks, parsed from the command line.
+struct Settings {
+  TI4Echelon::GamesGeneratorSettings games;
+
+  std::size_t repetitions{5};
+
+  std::string format{"json"};
+
+  std::filesystem::path output;
+};
+
+std::size_t non_negative_number(
+    const std::string& key, const std::string& text) {
+  const std::optional<int64_t> number{
+      TI4Echelon::string_to_integer_number(text)};
+  if (!number.has_value() || number.value() < 0) {
+    TI4Echelon::error(
+        "The value of " + key + " must be a non-negative integer: " + text);
+  }
+  return static_cast<std::size_t>(number.value());
+}
+
+Settings parse(const int argc, char* argv[]) {
+  Settings settings;
+  for (int index = 1; index < argc; ++index) {
+    const std::string key{argv[index]};
+    if (key == "--help") {
+      std::cout << Usage << std::endl;
+      exit(EXIT_SUCCESS);
+    }
+    if (index + 1 >= argc) {
+      TI4Echelon::error("Missing value for " + key + ". " + Usage);
+    }
+    const std::string value{argv[++index]};
+    if (key == "--games") {
+      settings.games.number_of_games = non_negative_number(key, value);
+    } else if (key == "--players") {
+      settings.games.number_of_players = non_negative_number(key, value);
+    } else if (key == "--repetitions") {
+      settings.repetitions = non_negative_number(key, value);
+    } else if (key == "--seed") {
+      settings.games.seed = non_negative_number(key, value);
+    } else if (key == "--format" && (value == "json" || value == "csv")) {
+      settings.format = value;
+    } else if (key == "--output") {
+      settings.output = value;
+    } else {
+      TI4Echelon::error(
+          "Unknown argument: " + key + " " + value + ". " + Usage);
+    }
+  }
+  return settings;
+}
+
+/// \brief Splits the text of a games file into the lines of each game.
+std::vector<std::vector<std::string_view>> game_lines(
+    const std::string_view text) noexcept {
+  std::vector<std::vector<std::string_view>> games(1);
+  std::size_t start{0};
+  while (start < text.size()) {
+    std::size_t end{text.find('\n', start)};
+    if (end == std::string_view::npos) {
+      end = text.size();
+    }
+    if (end == start) {
+      if (!games.back().empty()) {
+        games.emplace_back();
+      }
+    } else {
+      games.back().push_back(text.substr(start, end - start));
+    }
+    start = end + 1;
+  }
+  if (games.back().empty()) {
+    games.pop_back();
+  }
+  return games;
+}
+
+/// \brief Table with a given number of rows of numeric data, similar to the
+/// player and faction data files.
+TI4Echelon::Table numeric_table(const std::size_t number_of_rows) noexcept {
+  TI4Echelon::Table table;
+  for (std::size_t column = 0; column < 10; ++column) {
+    table.insert_column("Column" + std::to_string(column));
+  }
+  for (std::size_t row = 0; row < number_of_rows; ++row) {
+    table.column(0).insert_row(row);
+    table.column(1).insert_row(row / 2);
+    for (std::size_t column = 2; column < 10; ++column) {
+      table.column(column).insert_row(
+          {1000.0 + static_cast<double>(row * column % 997) / 7.0});
+    }
+  }
+  return table;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const Settings settings{parse(argc, argv)};
+  const std::filesystem::path directory{
+      std::filesystem::temp_directory_path()
+      / ("ti4-echelon-bench-" + std::to_string(::getpid()))};
+  std::filesystem::create_directories(directory);
+  const std::filesystem::path games_file{directory / "games.txt"};
+  const std::string text{TI4Echelon::GamesGenerator{settings.games}.print()};
+  std::ofstream{games_file} << text;
+  const std::vector<std::vector<std::string_view>> lines{game_lines(text)};
+  const std::size_t number_of_games{lines.size()};
+
+  TI4Echelon::Benchmarks benchmarks{settings.repetitions};
+  benchmarks.run("Game construction", number_of_games, [&] {
+    for (const std::vector<std::string_view>& game : lines) {
+      const TI4Echelon::Game parsed{game};
+    }
+  });
+  benchmarks.run("Games construction", number_of_games, [&] {
+    const TI4Echelon::Games games{games_file};
+  });
+
+  const TI4Echelon::Games games{[&] {
+    const TI4Echelon::SilentConsole silent_console;
+    return TI4Echelon::Games{games_file};
+  }()};
+  std::size_t number_of_seats{0};
+  std::vector<std::vector<std::size_t>> player_indices;
+  for (TI4Echelon::Games::const_reverse_iterator game = games.crbegin();
+       game != games.crend(); ++game) {
+    player_indices.emplace_back();
+    for (const TI4Echelon::Participant& participant : game->participants()) {
+      player_indices.back().push_back(participant.player_name().identifier());
+      ++number_of_seats;
+    }
+  }
+
+  benchmarks.run("PlayerEloRatings update", number_of_games, [&] {
+    TI4Echelon::PlayerEloRatings elo_ratings{
+        TI4Echelon::PlayerNameRegistry::get().size()};
+    std::size_t index{0};
+    for (TI4Echelon::Games::const_reverse_iterator game = games.crbegin();
+         game != games.crend(); ++game) {
+      elo_ratings.update(*game, player_indices[index]);
+      ++index;
+    }
+  });
+  benchmarks.run("FactionEloRatings update", number_of_games, [&] {
+    TI4Echelon::FactionEloRatings elo_ratings;
+    for (TI4Echelon::Games::const_reverse_iterator game = games.crbegin();
+         game != games.crend(); ++game) {
+      elo_ratings.update(*game);
+    }
+  });
+  benchmarks.run("Snapshot construction", number_of_seats, [&] {
+    std::vector<std::optional<TI4Echelon::Snapshot>> latest(
+        TI4Echelon::PlayerNameRegistry::get().size());
+    for (TI4Echelon::Games::const_reverse_iterator game = games.crbegin();
+         game != games.crend(); ++game) {
+      for (const TI4Echelon::Participant& participant : game->participants()) {
+        std::optional<TI4Echelon::Snapshot>& previous{
+            latest[participant.player_name().identifier()]};
+        previous = TI4Echelon::Snapshot{
+            participant.player_name(), *game, TI4Echelon::EloRating{},
+            previous.has_value() ? &previous.value() : nullptr};
+      }
+    }
+  });
+  benchmarks.run("Players construction", number_of_games, [&] {
+    const TI4Echelon::Players players{games};
+  });
+  benchmarks.run("Factions construction", number_of_games, [&] {
+    const TI4Echelon::Factions factions{games};
+  });
+  benchmarks.run("Incremental append", number_of_games, [&] {
+    const TI4Echelon::SilentConsole silent_console;
+    TI4Echelon::Games appended_games;
+    TI4Echelon::Players appended_players{appended_games};
+    TI4Echelon::Factions appended_factions{appended_games};
+    for (TI4Echelon::Games::const_reverse_iterator game = games.crbegin();
+         game != games.crend(); ++game) {
+      const TI4Echelon::Game& appended{appended_games.append(*game)};
+      appended_players.apply(appended);
+      appended_factions.apply(appended);
+    }
+  });
+  // Correcting the most recent game only applies the games since the latest
+  // periodic checkpoint again.
+  TI4Echelon::Games corrected_games{games};
+  TI4Echelon::Players corrected_players{[&] {
+    const TI4Echelon::SilentConsole silent_console;
+    return TI4Echelon::Players{corrected_games};
+  }()};
+  TI4Echelon::Factions corrected_factions{[&] {
+    const TI4Echelon::SilentConsole silent_console;
+    return TI4Echelon::Factions{corrected_games};
+  }()};
+  benchmarks.run("Correction replay", 1, [&] {
+    const std::size_t first_changed_index{corrected_games.replace(
+        corrected_games.size() - 1, *corrected_games.begin())};
+    corrected_players.correct(corrected_games, first_changed_index);
+    corrected_factions.correct(corrected_games, first_changed_index);
+  });
+  // Publishing a version for queries shares the players and factions with the
+  // published copy, so the next correction clones the ones it modifies.
+  benchmarks.run("Version publication", 1, [&] {
+    const TI4Echelon::Players published_players{corrected_players};
+    const TI4Echelon::Factions published_factions{corrected_factions};
+    const std::size_t first_changed_index{corrected_games.replace(
+        corrected_games.size() - 1, *corrected_games.begin())};
+    corrected_players.correct(corrected_games, first_changed_index);
+    corrected_factions.correct(corrected_games, first_changed_index);
+  });
+
+  benchmarks.run("Table construction", number_of_games, [&] {
+    const TI4Echelon::Table constructed{numeric_table(number_of_games)};
+  });
+  const TI4Echelon::Table table{numeric_table(number_of_games)};
+  benchmarks.run("Table print_as_data", number_of_games, [&] {
+    const std::string printed{table.print_as_data()};
+  });
+  benchmarks.run("Table print_as_markdown", number_of_games, [&] {
+    const std::string printed{table.print_as_markdown()};
+  });
+
+  const TI4Echelon::Players players{[&] {
+    const TI4Echelon::SilentConsole silent_console;
+    return TI4Echelon::Players{games};
+  }()};
+  const TI4Echelon::Factions factions{[&] {
+    const TI4Echelon::SilentConsole silent_console;
+    return TI4Echelon::Factions{games};
+  }()};
+  benchmarks.run("LeaderboardFileWriter", number_of_games, [&] {
+    TI4Echelon::LeaderboardFileWriter{directory, games, players, factions};
+  });
+  std::filesystem::remove_all(directory);
+
+  const std::string results{settings.format == "csv" ?
+                                benchmarks.print_as_csv() :
+                                benchmarks.print_as_json()};
+  if (settings.output.empty()) {
+    std::cout << results << std::endl;
+  } else {
+    std::ofstream{settings.output} << results << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+#include "GamesGenerator.hpp"
+
+namespace {
+
+const std::string Usage{
+    "Usage: ti4-echelon-generate [--games <number>] [--players <number>] "
+    "[--player-skew <number>] [--minimum-participants <number>] "
+    "[--maximum-participants <number>] [--faction-skew <number>] "
+    "[--custom-factions <probability>] [--teams <probability>] "
+    "[--goals <number>,<number>,...] [--durations <probability>] "
+    "[--from <YYYY-MM-DD>] [--to <YYYY-MM-DD>] [--seed <number>] "
+    "[--output <path>]"};
+
+/// \brief Settings of the generator tool, parsed from the command line.
+struct Settings {
+  TI4Echelon::GamesGeneratorSettings games;
+
+  std::filesystem::path output;
+};
+
+std::size_t non_negative_integer(
+    const std::string& key, const std::string& text) {
+  const std::optional<int64_t> number{
+      TI4Echelon::string_to_integer_number(text)};
+  if (!number.has_value() || number.value() < 0) {
+    TI4Echelon::error(
+        "The value of " + key + " must be a non-negative integer: " + text);
+  }
+  return static_cast<std::size_t>(number.value());
+}
+
+double real_number(const std::string& key, const std::string& text) {
+  const std::optional<double> number{
+      TI4Echelon::string_to_real_number(text)};
+  if (!number.has_value()) {
+    TI4Echelon::error("The value of " + key + " must be a number: " + text);
+  }
+  return number.value();
+}
+
+Settings parse(const int argc, char* argv[]) {
+  Settings settings;
+  for (int index = 1; index < argc; ++index) {
+    const std::string key{argv[index]};
+    if (key == "--help") {
+      std::cout << Usage << std::endl;
+      exit(EXIT_SUCCESS);
+    }
+    if (index + 1 >= argc) {
+      TI4Echelon::error("Missing value for " + key + ". " + Usage);
+    }
+    const std::string value{argv[++index]};
+    if (key == "--games") {
+      settings.games.number_of_games = non_negative_integer(key, value);
+    } else if (key == "--players") {
+      settings.games.number_of_players = non_negative_integer(key, value);
+    } else if (key == "--player-skew") {
+      settings.games.player_skew = real_number(key, value);
+    } else if (key == "--minimum-participants") {
+      settings.games.minimum_number_of_participants =
+          non_negative_integer(key, value);
+    } else if (key == "--maximum-participants") {
+      settings.games.maximum_number_of_participants =
+          non_negative_integer(key, value);
+    } else if (key == "--faction-skew") {
+      settings.games.faction_skew = real_number(key, value);
+    } else if (key == "--custom-factions") {
+      settings.games.custom_faction_probability = real_number(key, value);
+    } else if (key == "--teams") {
+      settings.games.teams_probability = real_number(key, value);
+    } else if (key == "--goals") {
+      settings.games.victory_point_goals.clear();
+      for (const std::string& goal :
+           TI4Echelon::split_by_delimiter(value, ',')) {
+        settings.games.victory_point_goals.push_back(
+            static_cast<int64_t>(non_negative_integer(key, goal)));
+      }
+    } else if (key == "--durations") {
+      settings.games.duration_probability = real_number(key, value);
+    } else if (key == "--from") {
+      settings.games.first_date = {value};
+    } else if (key == "--to") {
+      settings.games.last_date = {value};
+    } else if (key == "--seed") {
+      settings.games.seed = non_negative_integer(key, value);
+    } else if (key == "--output") {
+      settings.output = value;
+    } else {
+      TI4Echelon::error(
+          "Unknown argument: " + key + " " + value + ". " + Usage);
+    }
+  }
+  return settings;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  TI4Echelon::buffer_console_output();
+  const Settings settings{parse(argc, argv)};
+  const TI4Echelon::GamesGenerator generator{settings.games};
+  if (settings.output.empty()) {
+    generator.write(std::cout);
+  } else {
+    std::ofstream stream{settings.output};
+    if (!stream.is_open()) {
+      TI4Echelon::error(
+          "Could not open the file: " + settings.output.string());
+    }
+    generator.write(stream);
+  }
+  return EXIT_SUCCESS;
+}
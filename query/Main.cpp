@@ -0,0 +1,149 @@
+#include "QueryResponse.hpp"
+#include "StateFile.hpp"
+
+namespace {
+
+const std::string Usage{
+    "Usage: ti4-echelon-query --state <path> [--player <name>] "
+    "[--faction <name>] [--top-players <number>] [--top-factions <number>]"};
+
+/// \brief Query of the query tool, parsed from the command line.
+struct Settings {
+  std::filesystem::path state;
+
+  std::optional<std::string> player;
+
+  std::optional<std::string> faction;
+
+  std::optional<std::size_t> top_players;
+
+  std::optional<std::size_t> top_factions;
+};
+
+std::size_t non_negative_integer(
+    const std::string& key, const std::string& text) {
+  const std::optional<int64_t> number{
+      TI4Echelon::string_to_integer_number(text)};
+  if (!number.has_value() || number.value() < 0) {
+    TI4Echelon::error(
+        "The value of " + key + " must be a non-negative integer: " + text);
+  }
+  return static_cast<std::size_t>(number.value());
+}
+
+Settings parse(const int argc, char* argv[]) {
+  Settings settings;
+  for (int index = 1; index < argc; ++index) {
+    const std::string key{argv[index]};
+    if (key == "--help") {
+      std::cout << Usage << std::endl;
+      exit(EXIT_SUCCESS);
+    }
+    if (index + 1 >= argc) {
+      TI4Echelon::error("Missing value for " + key + ". " + Usage);
+    }
+    const std::string value{argv[++index]};
+    if (key == "--state") {
+      settings.state = value;
+    } else if (key == "--player") {
+      settings.player = value;
+    } else if (key == "--faction") {
+      settings.faction = value;
+    } else if (key == "--top-players") {
+      settings.top_players = non_negative_integer(key, value);
+    } else if (key == "--top-factions") {
+      settings.top_factions = non_negative_integer(key, value);
+    } else {
+      TI4Echelon::error(
+          "Unknown argument: " + key + " " + value + ". " + Usage);
+    }
+  }
+  if (settings.state.empty()) {
+    TI4Echelon::error("The state file (--state <path>) is missing. " + Usage);
+  }
+  return settings;
+}
+
+/// \brief Writes the name and latest statistics of a player or faction.
+void entity(TI4Echelon::JsonWriter& json,
+            const TI4Echelon::StateFile::Entity& entity_) noexcept {
+  json.key("name").value(entity_.name());
+  TI4Echelon::QueryResponse::statistics(json, entity_.latest_snapshot());
+}
+
+/// \brief Writes the top players or factions by average rating, as in the
+/// leaderboard.
+void top(TI4Echelon::JsonWriter& json, const std::string& key,
+         const TI4Echelon::StateFile::Entities& entities,
+         const std::size_t number) noexcept {
+  json.key(key).begin_array();
+  for (std::size_t position = 0;
+       position < std::min(number, entities.number_of_ranked()); ++position) {
+    json.begin_object();
+    json.key("rank").value(static_cast<uint64_t>(position + 1));
+    entity(json, entities.ranked(position));
+    json.end_object();
+  }
+  json.end_array();
+}
+
+/// \brief Player or faction with a given name, or no value if there is none
+/// or if it has no statistics.
+std::optional<TI4Echelon::StateFile::Entity> find(
+    const TI4Echelon::StateFile::Entities& entities,
+    const std::string_view name) noexcept {
+  const std::optional<TI4Echelon::StateFile::Entity> found{
+      entities.find(name)};
+  if (found.has_value() && !found.value().empty()) {
+    return found;
+  } else {
+    const std::optional<TI4Echelon::StateFile::Entity> no_entity;
+    return no_entity;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const Settings settings{parse(argc, argv)};
+  const TI4Echelon::StateFile state{settings.state};
+  TI4Echelon::JsonWriter json;
+  json.begin_object();
+  json.key("games").value(static_cast<uint64_t>(state.number_of_games()));
+  if (settings.player.has_value()) {
+    const std::optional<TI4Echelon::StateFile::Entity> player{
+        find(state.players(), settings.player.value())};
+    if (!player.has_value()) {
+      TI4Echelon::error(
+          "There is no player named '" + settings.player.value() + "'.");
+    }
+    json.key("player").begin_object();
+    entity(json, player.value());
+    json.end_object();
+  }
+  if (settings.faction.has_value()) {
+    // Accept any spelling of the faction's name.
+    const std::optional<TI4Echelon::FactionName> faction_name{
+        TI4Echelon::type<TI4Echelon::FactionName>(settings.faction.value())};
+    const std::optional<TI4Echelon::StateFile::Entity> faction{
+        find(state.factions(), faction_name.has_value() ?
+                                   TI4Echelon::label(faction_name.value()) :
+                                   settings.faction.value())};
+    if (!faction.has_value()) {
+      TI4Echelon::error(
+          "There is no faction named '" + settings.faction.value() + "'.");
+    }
+    json.key("faction").begin_object();
+    entity(json, faction.value());
+    json.end_object();
+  }
+  if (settings.top_players.has_value()) {
+    top(json, "players", state.players(), settings.top_players.value());
+  }
+  if (settings.top_factions.has_value()) {
+    top(json, "factions", state.factions(), settings.top_factions.value());
+  }
+  json.end_object();
+  std::cout << json.text() << std::endl;
+  return EXIT_SUCCESS;
+}
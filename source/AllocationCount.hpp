@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Include.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Whether heap allocations are counted. Off by default, such that
+/// allocations only pay for the count when the program is profiled or
+/// benchmarked.
+inline std::atomic<bool> CountAllocations{false};
+
+/// \brief Number of heap allocations performed by the program since they
+/// started being counted. Counted by the replacement global allocation
+/// functions of AllocationCounting.cpp, including the aligned ones, in the
+/// executables that link it. Stays zero in the other executables.
+inline std::atomic<std::size_t> NumberOfAllocations{0};
+
+}  // namespace TI4Echelon
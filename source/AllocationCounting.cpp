@@ -0,0 +1,79 @@
+// Replacement global allocation and deallocation functions that count heap
+// allocations for the profiler. They are defined in their own translation unit,
+// which is only linked into the executables that report allocations, such that
+// the other executables keep the default allocation functions.
+
+#include "AllocationCount.hpp"
+
+/// \brief Replacement global allocation function that counts heap allocations
+/// while they are being counted.
+void* operator new(const std::size_t size) {
+  if (TI4Echelon::CountAllocations.load(std::memory_order_relaxed)) {
+    TI4Echelon::NumberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* const pointer{std::malloc(size > 0 ? size : 1)};
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](const std::size_t size) {
+  return operator new(size);
+}
+
+/// \brief Replacement global allocation function for over-aligned types that
+/// counts heap allocations while they are being counted.
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+  if (TI4Echelon::CountAllocations.load(std::memory_order_relaxed)) {
+    TI4Echelon::NumberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  const std::size_t alignment_{static_cast<std::size_t>(alignment)};
+  // The size given to aligned_alloc must be a multiple of the alignment.
+  void* const pointer{std::aligned_alloc(
+      alignment_,
+      (std::max(size, std::size_t{1}) + alignment_ - 1) / alignment_
+          * alignment_)};
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void operator delete(void* const pointer, const std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* const pointer, const std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* const pointer, const std::size_t,
+                     const std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* const pointer, const std::size_t,
+                       const std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* const pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* const pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* const pointer, const std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* const pointer, const std::size_t) noexcept {
+  std::free(pointer);
+}
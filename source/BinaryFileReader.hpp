@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Echelon {
+
+/// \brief General-purpose binary file reader. Reads back the values written by
+/// a binary file writer, in the same order.
+/// \details The whole file is read into memory when the reader is constructed.
+/// Reading past the end of the file does not throw. Instead, the value read is
+/// default-initialized and the reader is no longer good, such that a truncated
+/// or corrupt file can be detected once all values are read.
+class BinaryFileReader {
+public:
+  /// \brief Reads a file. If the file cannot be read, the reader is empty and
+  /// not good.
+  BinaryFileReader(const std::filesystem::path& path) noexcept : path_(path) {
+    std::ifstream stream{path_.string(), std::ios::binary | std::ios::ate};
+    const std::streamoff size{stream.is_open() ? std::streamoff{stream.tellg()}
+                                               : std::streamoff{-1}};
+    if (size >= 0) {
+      data_.resize(static_cast<std::size_t>(size));
+      stream.seekg(0);
+      stream.read(data_.data(), static_cast<std::streamsize>(size));
+    }
+    good_ = size >= 0 && !stream.fail();
+  }
+
+  const std::filesystem::path& path() const noexcept {
+    return path_;
+  }
+
+  /// \brief Whether the file was read and every value read so far was within
+  /// the file.
+  bool good() const noexcept {
+    return good_;
+  }
+
+  /// \brief Whether every byte of the file has been read.
+  bool at_end() const noexcept {
+    return position_ == data_.size();
+  }
+
+  /// \brief Reads a trivially copyable value.
+  template <typename Type>
+  Type value() noexcept {
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "Only trivially copyable values can be read.");
+    Type value_{};
+    if (available(sizeof(Type))) {
+      std::memcpy(&value_, data_.data() + position_, sizeof(Type));
+      position_ += sizeof(Type);
+    }
+    return value_;
+  }
+
+  /// \brief Reads a number of elements that follow, each of which takes at
+  /// least a given number of bytes. If the remaining bytes cannot hold that
+  /// many elements, the reader is no longer good and zero is returned, such
+  /// that a corrupt number is never used to allocate memory.
+  uint64_t count(const std::size_t element_size) noexcept {
+    const uint64_t count_{value<uint64_t>()};
+    if (good_ && count_ <= (data_.size() - position_) / element_size) {
+      return count_;
+    }
+    good_ = false;
+    return 0;
+  }
+
+  /// \brief Reads the number of values of a vector followed by the values.
+  template <typename Type>
+  std::vector<Type> values() noexcept {
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "Only trivially copyable values can be read.");
+    const uint64_t size{count(sizeof(Type))};
+    std::vector<Type> values_(size);
+    if (size > 0) {
+      std::memcpy(
+          values_.data(), data_.data() + position_, size * sizeof(Type));
+      position_ += size * sizeof(Type);
+    }
+    return values_;
+  }
+
+  /// \brief Reads the length of a text followed by its characters.
+  std::string text() noexcept {
+    const uint64_t size{value<uint64_t>()};
+    std::string text_;
+    if (available(size)) {
+      text_.assign(data_.data() + position_, size);
+      position_ += size;
+    }
+    return text_;
+  }
+
+private:
+  std::filesystem::path path_;
+
+  std::string data_;
+
+  std::size_t position_{0};
+
+  bool good_{true};
+
+  /// \brief Whether a number of bytes remain to be read. If not, the reader is
+  /// no longer good.
+  bool available(const uint64_t size) noexcept {
+    if (good_ && size <= data_.size() - position_) {
+      return true;
+    }
+    good_ = false;
+    return false;
+  }
+
+};  // class BinaryFileReader
+
+}  // namespace TI4Echelon
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "FileWriter.hpp"
+
+namespace TI4Echelon {
+
+/// \brief General-purpose binary file writer. Values are written in the native
+/// byte order and layout of the machine.
+class BinaryFileWriter : public FileWriter {
+public:
+  /// \brief Writes a trivially copyable value.
+  template <typename Type>
+  void value(const Type& value) noexcept {
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "Only trivially copyable values can be written.");
+    if (!path_.empty()) {
+      content_.append(reinterpret_cast<const char*>(&value), sizeof(Type));
+    }
+  }
+
+  /// \brief Writes the number of values of a vector followed by the values.
+  template <typename Type>
+  void values(const std::vector<Type>& values) noexcept {
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "Only trivially copyable values can be written.");
+    value<uint64_t>(values.size());
+    if (!path_.empty()) {
+      content_.append(reinterpret_cast<const char*>(values.data()),
+                      values.size() * sizeof(Type));
+    }
+  }
+
+  /// \brief Writes the length of a text followed by its characters.
+  void text(const std::string& text) noexcept {
+    value<uint64_t>(text.size());
+    if (!path_.empty()) {
+      content_ += text;
+    }
+  }
+
+protected:
+  BinaryFileWriter(const std::filesystem::path& path,
+                   const std::filesystem::perms& permissions =
+                       {std::filesystem::perms::owner_read
+                        | std::filesystem::perms::owner_write
+                        | std::filesystem::perms::group_read
+                        | std::filesystem::perms::others_read})
+    : FileWriter(path, permissions) {}
+
+};  // class BinaryFileWriter
+
+}  // namespace TI4Echelon
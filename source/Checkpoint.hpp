@@ -0,0 +1,176 @@
+#pragma once
+
+#include "BinaryFileReader.hpp"
+#include "Games.hpp"
+#include "SnapshotHistory.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Text at the start of every checkpoint file.
+const std::string CheckpointSignature{"TI4 Echelon checkpoint"};
+
+/// \brief Version of the checkpoint file format. Checkpoint files of any other
+/// version are discarded.
+constexpr const uint32_t CheckpointVersion{1};
+
+/// \brief Player and faction statistics computed from the oldest games of a
+/// games file, read back from a checkpoint file written by a previous run.
+/// \details A checkpoint file is a versioned binary file. It records the number
+/// of games from which the statistics were computed and a fingerprint of these
+/// games, followed by a table of the player and faction names, and by the
+/// current Elo rating and snapshot history of each player and faction. A
+/// checkpoint only applies to a games file whose oldest games, in
+/// chronological order, have the same fingerprint. This is the case when new
+/// games are added to the games file, as long as they are not older than the
+/// games already in it. Only the new games then need to be applied to the
+/// statistics. Otherwise, the checkpoint is discarded and all games are
+/// applied.
+class Checkpoint {
+public:
+  /// \brief Statistics of a player or a faction at the time of the checkpoint.
+  struct Entry {
+    EloRating current_elo_rating;
+
+    SnapshotHistory snapshots;
+  };
+
+  /// \brief Default constructor. Initializes an empty checkpoint, from which
+  /// all games are applied.
+  Checkpoint() noexcept {}
+
+  /// \brief Reads a checkpoint file and checks it against the games. If the
+  /// path is empty, the file does not exist, or the file does not match the
+  /// games, the checkpoint is empty.
+  Checkpoint(const std::filesystem::path& path, const Games& games) noexcept {
+    if (path.empty()) {
+      return;
+    }
+    const ProfilerScope profiler_scope{"Load the checkpoint"};
+    if (!std::filesystem::exists(path)) {
+      message("The checkpoint file '" + path.string()
+              + "' does not exist yet. All games will be applied.");
+    } else if (read(path, games)) {
+      message("Loaded the statistics of the oldest "
+              + std::to_string(number_of_games_)
+              + " games from the checkpoint file '" + path.string() + "'. "
+              + (number_of_games_ < games.size()
+                     ? "Only the "
+                           + std::to_string(games.size() - number_of_games_)
+                           + " newer games will be applied."
+                     : "No newer games need to be applied."));
+    } else {
+      clear();
+      warning("The checkpoint file '" + path.string()
+              + "' does not match the games file. All games will be applied.");
+    }
+  }
+
+  /// \brief Whether the statistics were read from a checkpoint file.
+  bool loaded() const noexcept {
+    return loaded_;
+  }
+
+  /// \brief Whether the statistics were read from a checkpoint file computed
+  /// from all of the games, in which case the file is already up to date.
+  bool covers(const Games& games) const noexcept {
+    return loaded_ && number_of_games_ == games.size();
+  }
+
+  /// \brief Number of oldest games from which the statistics were computed.
+  /// These games do not need to be applied again.
+  std::size_t number_of_games() const noexcept {
+    return number_of_games_;
+  }
+
+  /// \brief Statistics of a player, or a null pointer if the player had not
+  /// played any of the games of the checkpoint.
+  const Entry* player(const PlayerName& name) const noexcept {
+    const std::unordered_map<std::string, Entry>::const_iterator found{
+        players_.find(name.value())};
+    if (found != players_.cend()) {
+      return &found->second;
+    } else {
+      return nullptr;
+    }
+  }
+
+  /// \brief Statistics of a faction, or a null pointer if the faction had not
+  /// been played in any of the games of the checkpoint.
+  const Entry* faction(const FactionName name) const noexcept {
+    const std::unordered_map<FactionName, Entry>::const_iterator found{
+        factions_.find(name)};
+    if (found != factions_.cend()) {
+      return &found->second;
+    } else {
+      return nullptr;
+    }
+  }
+
+private:
+  bool loaded_{false};
+
+  std::size_t number_of_games_{0};
+
+  std::unordered_map<std::string, Entry> players_;
+
+  std::unordered_map<FactionName, Entry> factions_;
+
+  /// \brief Reads a checkpoint file. Returns whether the file is a valid
+  /// checkpoint of the oldest games of the games file.
+  bool read(const std::filesystem::path& path, const Games& games) noexcept {
+    BinaryFileReader reader{path};
+    if (reader.text() != CheckpointSignature
+        || reader.value<uint32_t>() != CheckpointVersion) {
+      return false;
+    }
+    number_of_games_ = reader.value<uint64_t>();
+    const uint64_t fingerprint{reader.value<uint64_t>()};
+    if (!reader.good() || number_of_games_ > games.size()
+        || fingerprint != games.fingerprint(number_of_games_)) {
+      return false;
+    }
+    std::vector<std::string> names;
+    const uint64_t number_of_names{reader.value<uint64_t>()};
+    for (uint64_t index = 0; index < number_of_names && reader.good();
+         ++index) {
+      names.push_back(reader.text());
+    }
+    const uint64_t number_of_players{reader.value<uint64_t>()};
+    for (uint64_t index = 0; index < number_of_players && reader.good();
+         ++index) {
+      const uint64_t name_index{reader.value<uint64_t>()};
+      Entry entry{reader.value<EloRating>(), {}};
+      if (name_index >= names.size() || !entry.snapshots.read(reader)) {
+        return false;
+      }
+      players_.emplace(names[name_index], std::move(entry));
+    }
+    const uint64_t number_of_factions{reader.value<uint64_t>()};
+    for (uint64_t index = 0; index < number_of_factions && reader.good();
+         ++index) {
+      const uint64_t name_index{reader.value<uint64_t>()};
+      Entry entry{reader.value<EloRating>(), {}};
+      if (name_index >= names.size() || !entry.snapshots.read(reader)) {
+        return false;
+      }
+      const std::optional<FactionName> faction_name{
+          type<FactionName>(names[name_index])};
+      if (!faction_name.has_value()) {
+        return false;
+      }
+      factions_.emplace(faction_name.value(), std::move(entry));
+    }
+    loaded_ = reader.good() && reader.at_end();
+    return loaded_;
+  }
+
+  void clear() noexcept {
+    loaded_ = false;
+    number_of_games_ = 0;
+    players_.clear();
+    factions_.clear();
+  }
+
+};  // class Checkpoint
+
+}  // namespace TI4Echelon
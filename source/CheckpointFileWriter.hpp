@@ -0,0 +1,63 @@
+#pragma once
+
+#include "BinaryFileWriter.hpp"
+#include "Checkpoint.hpp"
+#include "Factions.hpp"
+#include "Players.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Writes the player and faction statistics computed from all games to
+/// a checkpoint file, such that the next run only needs to apply the games
+/// added to the games file since then.
+class CheckpointFileWriter : public BinaryFileWriter {
+public:
+  CheckpointFileWriter(const std::filesystem::path& path, const Games& games,
+                       const Players& players, const Factions& factions)
+    : BinaryFileWriter(path) {
+    const ProfilerScope profiler_scope{"Write the checkpoint"};
+    text(CheckpointSignature);
+    value(CheckpointVersion);
+    value<uint64_t>(games.size());
+    value(games.fingerprint(games.size()));
+    // Each name is written once in the table of names, and the players and
+    // factions refer to it by its index in the table.
+    value<uint64_t>(players.size() + factions.size());
+    for (const Player& player : players) {
+      text(player.name().value());
+    }
+    for (const Faction& faction : factions) {
+      text(label(faction.name()));
+    }
+    uint64_t name_index{0};
+    value<uint64_t>(players.size());
+    for (const Player& player : players) {
+      value(name_index);
+      value(current_elo_rating(player.latest_snapshot()));
+      player.snapshots().write(*this);
+      ++name_index;
+    }
+    value<uint64_t>(factions.size());
+    for (const Faction& faction : factions) {
+      value(name_index);
+      value(current_elo_rating(faction.latest_snapshot()));
+      faction.snapshots().write(*this);
+      ++name_index;
+    }
+    write();
+    message("Wrote the checkpoint file '" + path.string() + "'.");
+  }
+
+private:
+  static EloRating current_elo_rating(
+      const Snapshot* const latest_snapshot) noexcept {
+    if (latest_snapshot != nullptr) {
+      return latest_snapshot->current_elo_rating();
+    } else {
+      return {};
+    }
+  }
+
+};  // class CheckpointFileWriter
+
+}  // namespace TI4Echelon
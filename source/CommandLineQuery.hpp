@@ -0,0 +1,119 @@
+#pragma once
+
+#include "QueryResponse.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Answer to a query given on the command line, written as a JSON
+/// document with the same members as the answers of the query server. Only the
+/// parts of the query that are asked for are written, and the statistics that
+/// they need are the only ones that must be computed.
+class CommandLineQuery {
+public:
+  /// \brief Starts the answer with the number of games from which the
+  /// statistics are computed and, if any, the date as of which they are.
+  CommandLineQuery(const Games& games, const std::optional<Date>& as_of) {
+    json_.begin_object();
+    json_.key("games").value(static_cast<uint64_t>(games.size()));
+    if (as_of.has_value()) {
+      json_.key("as_of").value(as_of.value());
+    }
+  }
+
+  /// \brief Writes the rank, latest statistics, and history of a player.
+  void player(const Players& players, const std::string& name) {
+    const std::optional<PlayerName> player_name{PlayerName::find(name)};
+    const Players::const_iterator found{
+        player_name.has_value() ? players.find(player_name.value()) :
+                                  players.cend()};
+    if (found == players.cend() || found->latest_snapshot() == nullptr) {
+      error("There is no player named '" + name + "'.");
+    }
+    json_.key("player").begin_object();
+    entity(ranked(players), *found);
+    QueryResponse::history(json_, found->snapshots());
+    json_.end_object();
+  }
+
+  /// \brief Writes the rank, latest statistics, and history of a faction. Any
+  /// spelling of the faction's name is accepted.
+  void faction(const Factions& factions, const std::string& name) {
+    const std::optional<FactionName> faction_name{type<FactionName>(name)};
+    const Factions::const_iterator found{
+        faction_name.has_value() ? factions.find(faction_name.value()) :
+                                   factions.cend()};
+    if (found == factions.cend() || found->latest_snapshot() == nullptr) {
+      error("There is no faction named '" + name + "'.");
+    }
+    json_.key("faction").begin_object();
+    entity(ranked(factions), *found);
+    QueryResponse::history(json_, found->snapshots());
+    json_.end_object();
+  }
+
+  /// \brief Writes the players or factions ranked first by average rating, as
+  /// in the leaderboard, up to a given number of them.
+  template <typename Entities>
+  void top(const std::string& key, const Entities& entities,
+           const std::size_t number) noexcept {
+    const std::vector<const EntityOf<Entities>*> ranked_{ranked(entities)};
+    json_.key(key).begin_array();
+    for (std::size_t index = 0; index < std::min(number, ranked_.size());
+         ++index) {
+      json_.begin_object();
+      entity(ranked_, *ranked_[index]);
+      json_.end_object();
+    }
+    json_.end_array();
+  }
+
+  /// \brief Ends the answer and returns it.
+  const std::string& text() noexcept {
+    json_.end_object();
+    return json_.text();
+  }
+
+private:
+  JsonWriter json_;
+
+  /// \brief Player or faction type of the players or factions.
+  template <typename Entities>
+  using EntityOf = std::decay_t<decltype(*std::declval<Entities>().cbegin())>;
+
+  /// \brief Players or factions with statistics, ranked by average rating.
+  template <typename Entities>
+  static std::vector<const EntityOf<Entities>*> ranked(
+      const Entities& entities) noexcept {
+    std::vector<const EntityOf<Entities>*> ranked_;
+    for (const EntityOf<Entities>& entity_ : entities) {
+      if (entity_.latest_snapshot() != nullptr) {
+        ranked_.push_back(&entity_);
+      }
+    }
+    QueryResponse::rank(ranked_);
+    return ranked_;
+  }
+
+  /// \brief Writes the rank, name, and latest statistics of a player or
+  /// faction, given all of the ranked players or factions.
+  template <typename Entity>
+  void entity(const std::vector<const Entity*>& ranked_,
+              const Entity& entity_) noexcept {
+    json_.key("rank").value(static_cast<uint64_t>(
+        std::find(ranked_.cbegin(), ranked_.cend(), &entity_) - ranked_.cbegin()
+        + 1));
+    json_.key("name").value(name(entity_));
+    QueryResponse::statistics(json_, *entity_.latest_snapshot());
+  }
+
+  static std::string name(const Player& player) noexcept {
+    return player.name().value();
+  }
+
+  static std::string name(const Faction& faction) noexcept {
+    return label(faction.name());
+  }
+
+};  // class CommandLineQuery
+
+}  // namespace TI4Echelon
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Include.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Value that is shared between copies until one of them modifies it,
+/// at which point that copy first clones the value.
+/// \details Copying is therefore as cheap as copying a pointer, and a version
+/// of a value that is being read, for example by a query on another thread,
+/// is never modified. The value is only ever modified through write(), by the
+/// thread that owns this copy.
+template <typename Value>
+class CopyOnWrite {
+public:
+  CopyOnWrite(Value value) noexcept
+    : pointer_(std::make_shared<Value>(std::move(value))) {}
+
+  const Value& operator*() const noexcept {
+    return *pointer_;
+  }
+
+  const Value* operator->() const noexcept {
+    return pointer_.get();
+  }
+
+  /// \brief Modifiable value of this copy. The value is first cloned if it is
+  /// shared with another copy.
+  Value& write() noexcept {
+    if (pointer_.use_count() > 1) {
+      pointer_ = std::make_shared<Value>(*pointer_);
+    } else {
+      // The other copies may have been destroyed by other threads after
+      // reading the value. Synchronize with the release of their references
+      // before modifying the value.
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *pointer_;
+  }
+
+private:
+  std::shared_ptr<Value> pointer_;
+
+};  // class CopyOnWrite
+
+}  // namespace TI4Echelon
@@ -9,8 +9,12 @@ class DataFileWriter : public TextFileWriter {
 public:
   DataFileWriter(const std::filesystem::path& path, const Table& table)
     : TextFileWriter(path) {
-    line(table.print_as_data());
+    if (!path_.empty()) {
+      table.print_as_data(content_);
+      content_ += '\n';
+    }
     blank_line();
+    write();
   }
 
 };  // class DataFileWriter
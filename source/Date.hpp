@@ -63,13 +63,18 @@ public:
   }
 
   std::string print() const noexcept {
-    const std::string month_number{
-        month_number_ < 10 ? "0" + std::to_string(month_number_) :
-                             std::to_string(month_number_)};
-    const std::string day_number{
-        day_number_ < 10 ? "0" + std::to_string(day_number_) :
-                           std::to_string(day_number_)};
-    return std::to_string(year_) + "-" + month_number + "-" + day_number;
+    std::string text;
+    print(text);
+    return text;
+  }
+
+  /// \brief Appends the date in the YYYY-MM-DD format to an output buffer.
+  void print(std::string& output) const noexcept {
+    append_integer_number(output, year_);
+    output += month_number_ < 10 ? "-0" : "-";
+    append_integer_number(output, month_number_);
+    output += day_number_ < 10 ? "-0" : "-";
+    append_integer_number(output, day_number_);
   }
 
   bool operator==(const Date& other) const noexcept {
@@ -10,9 +10,12 @@ public:
   /// \brief Default constructor. Initializes the duration to zero.
   Duration() noexcept {}
 
+  /// \brief Constructor to a given number of minutes.
+  constexpr Duration(const int64_t minutes) noexcept : minutes_(minutes) {}
+
   /// \brief Constructor from a string of the form 1h05m or any subset of this
   /// form, such as 1h or 5m.
-  Duration(const std::string& text) noexcept {
+  Duration(const std::string& text) {
     if (!text.empty()) {
       std::string first_digits;
       char first_character{'\0'};
@@ -121,7 +124,7 @@ public:
 private:
   int64_t minutes_{0};
 
-  void parsing_error(const std::string& text) const noexcept {
+  void parsing_error(const std::string& text) const {
     error("'" + text + "' is not a valid time duration.");
   }
 
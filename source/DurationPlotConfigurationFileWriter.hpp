@@ -54,6 +54,7 @@ public:
                .string()
          + "\" u 1:2 w lp lw 2 pt 7 ps 0.1 lt rgb \"#000000\" t \""
          + games.duration_versus_number_of_players().print() + "\" , \\");
+    write();
   }
 
 private:
@@ -16,62 +16,16 @@ public:
   /// value to 1500.
   constexpr EloRating(const double value) noexcept : value_(value) {}
 
-  /// \brief Constructs an updated Elo rating for a player given a game and a
-  /// set of previous Elo ratings.
-  EloRating(
-      const PlayerName& player_name, const Game& game,
-      const std::unordered_map<PlayerName, EloRating>& previous_elo_ratings) {
-    const std::optional<Place> place{game.place(player_name)};
-    if (!place.has_value()) {
-      error("Player " + player_name.value()
-            + " is not a participant in the game: " + game.print());
-    }
-    EloRating elo_rating{
-        previous_elo_rating(player_name, previous_elo_ratings)};
-    // Update the Elo rating using the actual and expected outcomes.
-    for (const Participant& participant : game.participants()) {
-      // Do not compete against yourself or your allies. The place handles both
-      // of these checks.
-      if (place.value() != participant.place()) {
-        const EloRating opponent_elo_rating{previous_elo_rating(
-            participant.player_name(), previous_elo_ratings)};
-        const double actual_outcome{place.value().outcome(participant.place())};
-        const double expected_outcome{
-            elo_rating.expected_outcome(opponent_elo_rating)};
-        elo_rating += update_factor_ * (actual_outcome - expected_outcome);
-      }
-    }
-    value_ = elo_rating.value();
-  }
-
-  /// \brief Constructs an updated Elo rating for a faction given a game and a
-  /// set of previous Elo ratings.
-  EloRating(
-      const FactionName faction_name, const Game& game,
-      const std::unordered_map<FactionName, EloRating>& previous_elo_ratings) {
-    const std::set<Place, Place::sort> places{game.places(faction_name)};
-    if (!places.empty()) {
-      EloRating elo_rating{
-          previous_elo_rating(faction_name, previous_elo_ratings)};
-      for (const Place& place : places) {
-        // Update the Elo rating using the actual and expected outcomes.
-        for (const Participant& participant : game.participants()) {
-          // Do not compete against yourself or your allies. The place handles
-          // both of these checks.
-          if (place != participant.place()) {
-            const EloRating opponent_elo_rating{previous_elo_rating(
-                participant.faction_name(), previous_elo_ratings)};
-            const double actual_outcome{place.outcome(participant.place())};
-            const double expected_outcome{
-                elo_rating.expected_outcome(opponent_elo_rating)};
-            elo_rating += update_factor_ * (actual_outcome - expected_outcome);
-          }
-        }
-      }
-      value_ = elo_rating.value();
-    } else {
-      error("Faction " + label(faction_name)
-            + " is not a participant in the game: " + game.print());
+  /// \brief Updates this Elo rating given the place achieved in a game and the
+  /// place and previous Elo rating of another participant in that game. A
+  /// participant in the same place is either oneself or an ally, and is
+  /// therefore ignored.
+  void update(const Place& place, const Place& opponent_place,
+              const EloRating& opponent_elo_rating) noexcept {
+    if (place != opponent_place) {
+      const double actual_outcome{place.outcome(opponent_place)};
+      const double expected_outcome_{expected_outcome(opponent_elo_rating)};
+      value_ += update_factor_ * (actual_outcome - expected_outcome_);
     }
   }
 
@@ -81,7 +35,14 @@ public:
 
   /// \brief Print the Elo rating as an integer.
   std::string print() const noexcept {
-    return std::to_string(static_cast<int64_t>(std::round(value_)));
+    std::string text;
+    print(text);
+    return text;
+  }
+
+  /// \brief Appends the Elo rating as an integer to an output buffer.
+  void print(std::string& output) const noexcept {
+    append_integer_number(output, static_cast<int64_t>(std::round(value_)));
   }
 
   constexpr bool operator==(const EloRating& other) const noexcept {
@@ -181,34 +142,6 @@ private:
               + std::pow(10.0, (opponent_elo_rating.value() - value_) / 400.0));
   }
 
-  static EloRating previous_elo_rating(
-      const PlayerName& player_name,
-      const std::unordered_map<PlayerName, EloRating>& previous_elo_ratings) {
-    const std::unordered_map<PlayerName, EloRating>::const_iterator found{
-        previous_elo_ratings.find(player_name)};
-    if (found != previous_elo_ratings.cend()) {
-      return found->second;
-    } else {
-      error("Player " + player_name.value()
-            + " is missing from the previous Elo ratings.");
-      return {};
-    }
-  }
-
-  static EloRating previous_elo_rating(
-      const FactionName faction_name,
-      const std::unordered_map<FactionName, EloRating>& previous_elo_ratings) {
-    const std::unordered_map<FactionName, EloRating>::const_iterator found{
-        previous_elo_ratings.find(faction_name)};
-    if (found != previous_elo_ratings.cend()) {
-      return found->second;
-    } else {
-      error("Faction " + label(faction_name)
-            + " is missing from the previous Elo ratings.");
-      return {};
-    }
-  }
-
 };  // class EloRating
 
 }  // namespace TI4Echelon
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "EloRating.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Current Elo ratings of all factions, stored in a fixed-size array
+/// indexed by faction name.
+/// \details Updating the Elo ratings with a game only reads and writes the Elo
+/// ratings of the factions that participated in that game.
+class FactionEloRatings {
+public:
+  /// \brief Default constructor. Initializes the Elo rating of every faction to
+  /// the default Elo rating.
+  FactionEloRatings() noexcept {}
+
+  const EloRating& operator[](const FactionName faction_name) const noexcept {
+    return data_[static_cast<std::size_t>(faction_name)];
+  }
+
+  /// \brief Sets the Elo rating of a faction, such as one read from a
+  /// checkpoint.
+  void assign(
+      const FactionName faction_name, const EloRating& elo_rating) noexcept {
+    data_[static_cast<std::size_t>(faction_name)] = elo_rating;
+  }
+
+  /// \brief Updates the Elo ratings of the factions that participated in a
+  /// game.
+  /// \details A faction that appears in several places in the same game, such
+  /// as the Custom faction, is updated once for each of its distinct places.
+  void update(const Game& game) noexcept {
+    // Gather the previous Elo ratings of the participants before any of them
+    // are updated.
+    previous_.clear();
+    for (const Participant& participant : game.participants()) {
+      previous_.emplace_back(
+          participant.place(), (*this)[participant.faction_name()]);
+    }
+    // The participants are sorted by place, so each faction's places are
+    // visited in ascending order.
+    updated_.clear();
+    for (const Participant& participant : game.participants()) {
+      std::vector<Update>::iterator update{std::find_if(
+          updated_.begin(), updated_.end(), [&](const Update& existing) {
+            return existing.faction_name == participant.faction_name();
+          })};
+      if (update == updated_.end()) {
+        updated_.push_back({participant.faction_name(), participant.place(),
+                            (*this)[participant.faction_name()]});
+        update = updated_.end() - 1;
+      } else if (update->place == participant.place()) {
+        continue;
+      } else {
+        update->place = participant.place();
+      }
+      for (const std::pair<Place, EloRating>& opponent : previous_) {
+        update->elo_rating.update(
+            update->place, opponent.first, opponent.second);
+      }
+    }
+    for (const Update& update : updated_) {
+      data_[static_cast<std::size_t>(update.faction_name)] = update.elo_rating;
+    }
+  }
+
+private:
+  /// \brief Updated Elo rating of a faction in the game being processed, along
+  /// with the last place of that faction that was accounted for.
+  struct Update {
+    FactionName faction_name;
+
+    Place place;
+
+    EloRating elo_rating;
+  };
+
+  /// \brief Current Elo rating of each faction, indexed by faction name.
+  std::array<EloRating, NumberOfFactionNames> data_;
+
+  /// \brief Places and previous Elo ratings of the participants of the game
+  /// being processed. Kept as a member to avoid an allocation per game.
+  std::vector<std::pair<Place, EloRating>> previous_;
+
+  /// \brief Updated Elo ratings of the factions of the game being processed.
+  /// Kept as a member to avoid an allocation per game.
+  std::vector<Update> updated_;
+
+};  // class FactionEloRatings
+
+}  // namespace TI4Echelon
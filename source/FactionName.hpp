@@ -33,6 +33,10 @@ enum class FactionName : int8_t {
   Custom,
 };
 
+/// \brief Number of faction names, including the Custom faction name.
+constexpr const std::size_t NumberOfFactionNames{
+    static_cast<std::size_t>(FactionName::Custom) + 1};
+
 template <>
 const std::unordered_map<FactionName, std::string> labels<FactionName>{
     {FactionName::Arborec,              "Arborec"                },
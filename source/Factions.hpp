@@ -1,19 +1,89 @@
 #pragma once
 
+#include "Checkpoint.hpp"
+#include "CopyOnWrite.hpp"
 #include "Faction.hpp"
+#include "FactionEloRatings.hpp"
 #include "Games.hpp"
 
 namespace TI4Echelon {
 
 /// \brief A set of factions.
+/// \details Each faction is shared between copies of the factions until one of
+/// the copies modifies it, as with the players.
 class Factions {
 public:
-  /// \brief Constructs all faction data given the games.
-  Factions(const Games& games) noexcept {
+  /// \brief Constructs all faction data given the games. If a checkpoint of
+  /// the oldest games is given, the factions' statistics are restored from it
+  /// and only the newer games are applied.
+  Factions(const Games& games,
+           const Checkpoint& checkpoint = Checkpoint{}) noexcept {
+    const ProfilerScope profiler_scope{"Calculate the faction statistics"};
     initialize_data(games);
     initialize_indices();
+    restore(checkpoint);
     update(games);
-    message(print());
+    if (console_messages()) {
+      message(print());
+    }
+  }
+
+  /// \brief Number of games applied to the factions so far.
+  std::size_t number_of_games() const noexcept {
+    return number_of_games_;
+  }
+
+  /// \brief Applies a game played after all of the games applied so far, such
+  /// as a game just appended to the games. Only the factions that participated
+  /// in the game are updated. A faction that has not been played in any game
+  /// yet is first inserted into the factions, without a plot half or color.
+  void apply(const Game& game) {
+    if (game.index() != number_of_games_) {
+      error("The game '" + game.print()
+            + "' cannot be applied to the factions because it is not the next "
+              "game in chronological order.");
+    }
+    if (periodic_checkpoints_.due(number_of_games_)) {
+      record_periodic_checkpoint();
+    }
+    for (const Participant& participant : game.participants()) {
+      if (!exists(participant.faction_name())) {
+        insert(participant.faction_name());
+      }
+    }
+    elo_ratings_.update(game);
+    // A faction such as the Custom faction can appear multiple times in the
+    // same game, but it is only updated once per game.
+    std::bitset<NumberOfFactionNames> updated_faction_names;
+    for (const Participant& participant : game.participants()) {
+      const std::size_t faction_index{
+          static_cast<std::size_t>(participant.faction_name())};
+      if (updated_faction_names.test(faction_index)) {
+        continue;
+      }
+      updated_faction_names.set(faction_index);
+      Faction& faction{
+          data_[indices_.find(participant.faction_name())->second].write()};
+      faction.update(game, elo_ratings_[participant.faction_name()]);
+      update_lowest_and_highest_elo_ratings(faction);
+    }
+    ++number_of_games_;
+  }
+
+  /// \brief Corrects the factions after past games were edited, inserted, or
+  /// removed, given the index of the earliest game that changed. The factions
+  /// are rolled back to the latest periodic checkpoint taken before that game,
+  /// and only the games from that checkpoint onwards are applied again. If
+  /// games were only appended, they are simply applied. Factions that are no
+  /// longer played in any game are removed, and the plot halves and colors are
+  /// assigned again.
+  void correct(const Games& games, const std::size_t first_changed_index) {
+    if (first_changed_index < number_of_games_) {
+      roll_back(first_changed_index);
+    }
+    update(games);
+    erase_factions_without_games();
+    initialize_halves_and_colors();
   }
 
   bool need_two_plots() const noexcept {
@@ -31,15 +101,26 @@ public:
   std::string print() const noexcept {
     std::stringstream stream;
     stream << "Calculated statistics for " << data_.size() << " factions:";
-    for (const Faction& faction : data_) {
-      stream << std::endl << "- " << faction.print() << ".";
+    for (const CopyOnWrite<Faction>& faction : data_) {
+      stream << '\n' << "- " << faction->print() << ".";
     }
     return stream.str();
   }
 
-  struct const_iterator : public std::vector<Faction>::const_iterator {
-    const_iterator(const std::vector<Faction>::const_iterator i) noexcept
-      : std::vector<Faction>::const_iterator(i) {}
+  struct const_iterator
+    : public std::vector<CopyOnWrite<Faction>>::const_iterator {
+    const_iterator(
+        const std::vector<CopyOnWrite<Faction>>::const_iterator i) noexcept
+      : std::vector<CopyOnWrite<Faction>>::const_iterator(i) {}
+
+    const Faction& operator*() const noexcept {
+      return *std::vector<CopyOnWrite<Faction>>::const_iterator::operator*();
+    }
+
+    const Faction* operator->() const noexcept {
+      return std::vector<CopyOnWrite<Faction>>::const_iterator::operator*()
+          .operator->();
+    }
   };
 
   bool empty() const noexcept {
@@ -87,46 +168,88 @@ private:
 
   EloRating highest_elo_rating_;
 
-  std::vector<Faction> data_;
+  std::vector<CopyOnWrite<Faction>> data_;
 
   std::unordered_map<FactionName, std::size_t> indices_;
 
+  /// \brief Current Elo rating of each faction.
+  FactionEloRatings elo_ratings_;
+
+  std::size_t number_of_games_{0};
+
+  /// \brief State of the factions at a periodic checkpoint.
+  struct PeriodicCheckpoint {
+    EloRating lowest_elo_rating;
+
+    EloRating highest_elo_rating;
+
+    /// \brief State of each faction, indexed by faction name. There are few
+    /// factions, so all of them are recorded.
+    std::array<EntityCheckpoint, NumberOfFactionNames> factions;
+
+    /// \brief Checkpoint that replaces a checkpoint and the previous one,
+    /// given the previous one first. Each checkpoint holds the state of every
+    /// faction, so this is the later checkpoint.
+    static PeriodicCheckpoint merge(
+        const PeriodicCheckpoint&,
+        const PeriodicCheckpoint& checkpoint) noexcept {
+      return checkpoint;
+    }
+  };
+
+  PeriodicCheckpoints<PeriodicCheckpoint> periodic_checkpoints_;
+
   /// \brief Initialize the factions with their names and colors.
   /// \details Only a limited number of factions with the most games played are
   /// assigned a color.
   void initialize_data(const Games& games) noexcept {
-    const std::set<FactionName> played_faction_names_{
-        played_faction_names(games)};
+    for (const FactionName faction_name : played_faction_names(games)) {
+      data_.emplace_back(Faction{faction_name});
+    }
+    std::sort(data_.begin(), data_.end(),
+              [](const CopyOnWrite<Faction>& faction_1,
+                 const CopyOnWrite<Faction>& faction_2) {
+                return *faction_1 < *faction_2;
+              });
+    initialize_halves_and_colors();
+  }
+
+  /// \brief Assigns a plot half and a color to each faction other than the
+  /// Custom faction, in alphabetical order. If there are more factions than
+  /// colors, the factions are split into two halves, each with its own plot.
+  /// Only the factions whose half or color changes are modified.
+  void initialize_halves_and_colors() noexcept {
+    std::set<FactionName> faction_names;
+    for (const CopyOnWrite<Faction>& faction : data_) {
+      faction_names.insert(faction->name());
+    }
     const std::size_t number_of_played_non_custom_faction_names{
-        number_of_non_custom_factions(played_faction_names_)};
+        number_of_non_custom_factions(faction_names)};
     initialize_need_two_plots(number_of_played_non_custom_faction_names);
     std::size_t first_half_index{0};
     std::size_t second_half_index{0};
-    for (const FactionName faction_name : played_faction_names_) {
-      if (faction_name == FactionName::Custom) {
-        data_.emplace_back(faction_name);
+    for (std::size_t index = 0; index < data_.size(); ++index) {
+      std::optional<Half> half;
+      std::optional<Color> color;
+      if (data_[index]->name() == FactionName::Custom) {
+        // The Custom faction does not appear in plots.
+      } else if (need_two_plots_
+                 && index >= std::lround(
+                        0.5
+                        * static_cast<double>(
+                            number_of_played_non_custom_faction_names))) {
+        half = Half::Second;
+        color = plot_data_color(second_half_index);
+        ++second_half_index;
       } else {
-        if (need_two_plots_) {
-          if (data_.size() < std::lround(
-                  0.5
-                  * static_cast<double>(
-                      number_of_played_non_custom_faction_names))) {
-            data_.emplace_back(
-                faction_name, Half::First, plot_data_color(first_half_index));
-            ++first_half_index;
-          } else {
-            data_.emplace_back(
-                faction_name, Half::Second, plot_data_color(second_half_index));
-            ++second_half_index;
-          }
-        } else {
-          data_.emplace_back(
-              faction_name, Half::First, plot_data_color(first_half_index));
-          ++first_half_index;
-        }
+        half = Half::First;
+        color = plot_data_color(first_half_index);
+        ++first_half_index;
+      }
+      if (data_[index]->half() != half || data_[index]->color() != color) {
+        data_[index].write().set_half_and_color(half, color);
       }
     }
-    std::sort(data_.begin(), data_.end(), Faction::sort());
   }
 
   std::set<FactionName> played_faction_names(
@@ -151,44 +274,111 @@ private:
 
   void initialize_indices() noexcept {
     for (std::size_t index = 0; index < data_.size(); ++index) {
-      indices_.emplace(data_[index].name(), index);
+      indices_.emplace(data_[index]->name(), index);
+    }
+  }
+
+  /// \brief Inserts a faction that has not been played in any game yet, such
+  /// that the factions remain sorted by name.
+  void insert(const FactionName name) noexcept {
+    data_.insert(std::lower_bound(data_.begin(), data_.end(), name,
+                                  [](const CopyOnWrite<Faction>& faction,
+                                     const FactionName name_) {
+                                    return faction->name() < name_;
+                                  }),
+                 Faction{name});
+    indices_.clear();
+    initialize_indices();
+  }
+
+  /// \brief Removes the factions that are not played in any game, such as
+  /// after the only games of a faction were corrected.
+  void erase_factions_without_games() noexcept {
+    data_.erase(std::remove_if(data_.begin(), data_.end(),
+                               [](const CopyOnWrite<Faction>& faction) {
+                                 return faction->snapshots().empty();
+                               }),
+                data_.end());
+    indices_.clear();
+    initialize_indices();
+  }
+
+  void record_periodic_checkpoint() noexcept {
+    PeriodicCheckpoint checkpoint{lowest_elo_rating_, highest_elo_rating_, {}};
+    for (const CopyOnWrite<Faction>& faction : data_) {
+      checkpoint.factions[static_cast<std::size_t>(faction->name())] =
+          faction->checkpoint();
+    }
+    periodic_checkpoints_.record(number_of_games_, std::move(checkpoint));
+  }
+
+  /// \brief Rolls the factions back to the latest periodic checkpoint taken no
+  /// later than the game with a given index, or to before the first game if
+  /// there is no such checkpoint. The current Elo rating of each faction is
+  /// that of the faction's latest remaining snapshot. Only the factions played
+  /// in games since the checkpoint are modified.
+  void roll_back(const std::size_t game_index) noexcept {
+    const PeriodicCheckpoints<PeriodicCheckpoint>::Record* const checkpoint{
+        periodic_checkpoints_.rewind(game_index)};
+    lowest_elo_rating_ = {};
+    highest_elo_rating_ = {};
+    number_of_games_ = 0;
+    if (checkpoint != nullptr) {
+      lowest_elo_rating_ = checkpoint->second->lowest_elo_rating;
+      highest_elo_rating_ = checkpoint->second->highest_elo_rating;
+      number_of_games_ = checkpoint->first;
+    }
+    for (CopyOnWrite<Faction>& faction : data_) {
+      const EntityCheckpoint faction_checkpoint{
+          checkpoint != nullptr
+              ? checkpoint->second
+                    ->factions[static_cast<std::size_t>(faction->name())]
+              : EntityCheckpoint{}};
+      if (faction->number_of_snapshots()
+          != faction_checkpoint.number_of_snapshots) {
+        faction.write().roll_back(faction_checkpoint);
+      }
+      const Snapshot* const latest_snapshot{faction->latest_snapshot()};
+      elo_ratings_.assign(
+          faction->name(), latest_snapshot != nullptr
+                              ? latest_snapshot->current_elo_rating()
+                              : EloRating{});
+    }
+  }
+
+  /// \brief Restores the statistics and current Elo ratings of the factions
+  /// from a checkpoint, along with the number of games applied to them.
+  void restore(const Checkpoint& checkpoint) noexcept {
+    for (CopyOnWrite<Faction>& faction : data_) {
+      const Checkpoint::Entry* const entry{checkpoint.faction(faction->name())};
+      if (entry != nullptr) {
+        faction.write().restore(entry->snapshots);
+        elo_ratings_.assign(faction->name(), entry->current_elo_rating);
+        update_lowest_and_highest_elo_ratings(*faction);
+      }
     }
+    number_of_games_ = checkpoint.number_of_games();
   }
 
-  /// \brief Update all the factions with all the games.
+  /// \brief Update the factions with all the games that were not applied yet.
   void update(const Games& games) noexcept {
     // Iterate through the games in chronological order.
     // The games are listed in reverse-chronological order, so use a reverse
     // iterator.
-    for (Games::const_reverse_iterator game = games.crbegin();
+    for (Games::const_reverse_iterator game{
+             games.crbegin() + static_cast<std::ptrdiff_t>(number_of_games_)};
          game != games.crend(); ++game) {
-      const std::unordered_map<FactionName, EloRating> current_elo_ratings_{
-          current_elo_ratings()};
-      for (Faction& faction : data_) {
-        faction.update(*game, current_elo_ratings_);
-        if (faction.lowest_elo_rating() < lowest_elo_rating_) {
-          lowest_elo_rating_ = faction.lowest_elo_rating();
-        }
-        if (faction.highest_elo_rating() > highest_elo_rating_) {
-          highest_elo_rating_ = faction.highest_elo_rating();
-        }
-      }
+      apply(*game);
     }
   }
 
-  std::unordered_map<FactionName, EloRating>
-  current_elo_ratings() const noexcept {
-    std::unordered_map<FactionName, EloRating> elo_ratings_;
-    for (const Faction& faction : data_) {
-      const std::optional<Snapshot> latest_snapshot{faction.latest_snapshot()};
-      if (latest_snapshot.has_value()) {
-        elo_ratings_.emplace(
-            faction.name(), latest_snapshot.value().current_elo_rating());
-      } else {
-        elo_ratings_.emplace(faction.name(), EloRating{});
-      }
+  void update_lowest_and_highest_elo_ratings(const Faction& faction) noexcept {
+    if (faction.lowest_elo_rating() < lowest_elo_rating_) {
+      lowest_elo_rating_ = faction.lowest_elo_rating();
+    }
+    if (faction.highest_elo_rating() > highest_elo_rating_) {
+      highest_elo_rating_ = faction.highest_elo_rating();
     }
-    return elo_ratings_;
   }
 
 };  // class Factions
@@ -1,14 +1,19 @@
 #pragma once
 
-#include "File.hpp"
+#include <unistd.h>
+
+#include "OutputManifest.hpp"
 
 namespace TI4Echelon {
 
-/// \brief General-purpose file writer.
-class FileWriter : public File<std::ofstream> {
+/// \brief General-purpose file writer. The content is accumulated in memory and
+/// written to the file in a single block once it is complete. If an output
+/// manifest is open and the file already has the same content, the file is
+/// left untouched.
+class FileWriter {
 public:
-  ~FileWriter() noexcept {
-    set_permissions();
+  const std::filesystem::path& path() const noexcept {
+    return path_;
   }
 
   const std::filesystem::perms& permissions() const noexcept {
@@ -22,18 +27,95 @@ protected:
                   | std::filesystem::perms::owner_write
                   | std::filesystem::perms::group_read
                   | std::filesystem::perms::others_read})
-    : File(path), permissions_(permissions) {}
+    : path_(path), permissions_(permissions) {
+    if (!path_.empty()) {
+      existed_ = std::filesystem::exists(path_);
+      // Check that the file can be written without creating or truncating it,
+      // such that an unchanged file keeps its content and modification time.
+      const std::filesystem::path checked{
+          existed_ ? path_ :
+                     (path_.has_parent_path() ? path_.parent_path() :
+                                                std::filesystem::path{"."})};
+      if (::access(checked.c_str(), W_OK) != 0) {
+        error("Could not open the file: " + path_.string());
+      }
+    }
+  }
+
+  std::filesystem::path path_;
 
   std::filesystem::perms permissions_;
 
+  /// \brief Content accumulated so far, written to the file by write().
+  std::string content_;
+
+  /// \brief Whether the file existed before this writer was constructed.
+  bool existed_{false};
+
+  /// \brief Whether to write the content to a temporary file that then
+  /// replaces the file, such that a reader that mapped the previous file into
+  /// memory keeps reading it unchanged, and a new reader never sees a partially
+  /// written file.
+  bool replace_atomically_{false};
+
   void set_permissions() noexcept {
     if (!path_.empty()) {
-      if (std::filesystem::exists(path_)) {
-        std::filesystem::permissions(path_, permissions_);
+      std::error_code error_code;
+      if (std::filesystem::exists(path_, error_code)) {
+        std::filesystem::permissions(path_, permissions_, error_code);
+        if (error_code) {
+          warning("Could not set the permissions of the file '"
+                  + path_.string() + "': " + error_code.message());
+        }
       }
     }
   }
 
+  /// \brief Writes the accumulated content to the file, unless the output
+  /// manifest reports that the file already has this content. Called by each
+  /// writer once its content is complete. The content hash is only recorded in
+  /// the output manifest once the file is successfully written, such that a
+  /// file that failed to be written is written again by the next run.
+  void write() {
+    if (path_.empty()) {
+      return;
+    }
+    const uint64_t hash{content_hash(content_)};
+    if (!OutputManifest::get().must_write(path_, hash, existed_)) {
+      return;
+    }
+    const std::filesystem::path written{
+        replace_atomically_ ? std::filesystem::path{path_.string() + ".tmp"} :
+                              path_};
+    std::ofstream file{written.string(), std::ios::binary | std::ios::trunc};
+    file.write(content_.data(), static_cast<std::streamsize>(content_.size()));
+    file.close();
+    if (file.fail()) {
+      remove_temporary_file(written);
+      error("Could not write the file: " + written.string());
+    }
+    if (replace_atomically_) {
+      std::error_code error_code;
+      std::filesystem::rename(written, path_, error_code);
+      if (error_code) {
+        remove_temporary_file(written);
+        error("Could not replace the file '" + path_.string() + "' with '"
+              + written.string() + "': " + error_code.message());
+      }
+    }
+    set_permissions();
+    OutputManifest::get().written(path_, hash);
+  }
+
+  /// \brief Removes the temporary file to which the content is written when
+  /// the file is replaced atomically. Does nothing otherwise.
+  void remove_temporary_file(const std::filesystem::path& written) noexcept {
+    if (replace_atomically_) {
+      std::error_code error_code;
+      std::filesystem::remove(written, error_code);
+    }
+  }
+
 };  // class FileWriter
 
 }  // namespace TI4Echelon
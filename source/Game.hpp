@@ -4,7 +4,6 @@
 #include "Duration.hpp"
 #include "GameMode.hpp"
 #include "Participants.hpp"
-#include "Team.hpp"
 
 namespace TI4Echelon {
 
@@ -17,8 +16,9 @@ public:
 
   /// \brief Construct a game from a list of lines containing a date and a goal
   /// number of victory points followed by a list of places, player names,
-  /// victory points, and faction names.
-  Game(const std::vector<std::string> lines) {
+  /// victory points, and faction names. The lines are views into the text of
+  /// the games file and are not copied.
+  Game(const std::vector<std::string_view>& lines) {
     // 1 header line with a line for each of at least 2 players implies at least
     // 3 lines in total.
     if (lines.size() >= 3) {
@@ -27,9 +27,10 @@ public:
         initialize_player(lines[index]);
       }
       check_mode();
+      initialize_fingerprint(lines);
     } else {
       std::string text;
-      for (const std::string& line : lines) {
+      for (const std::string_view line : lines) {
         if (!text.empty()) {
           text += ";";
         }
@@ -47,6 +48,25 @@ public:
     return date_;
   }
 
+  /// \brief Hash of the lines from which this game was parsed. Identifies this
+  /// game when checking whether a games file starts with the same games as a
+  /// previous one.
+  constexpr uint64_t fingerprint() const noexcept {
+    return fingerprint_;
+  }
+
+  /// \brief Hash of the lines of a game, without parsing them. Equal to the
+  /// fingerprint of the game parsed from these lines.
+  static uint64_t fingerprint(
+      const std::vector<std::string_view>& lines) noexcept {
+    uint64_t hash{content_hash("")};
+    for (const std::string_view line : lines) {
+      hash = content_hash(line, hash);
+      hash = content_hash("\n", hash);
+    }
+    return hash;
+  }
+
   constexpr const VictoryPoints& victory_point_goal() const noexcept {
     return victory_point_goal_;
   }
@@ -64,9 +84,13 @@ public:
   }
 
   std::size_t number_of_players_on_team(const Place& place) const {
-    const std::set<Team, Team::sort>::const_iterator team{teams_.find(place)};
-    if (team != teams_.cend()) {
-      return team->size();
+    const std::size_t number_of_players{static_cast<std::size_t>(std::count_if(
+        participants_.cbegin(), participants_.cend(),
+        [&](const Participant& participant) {
+          return participant.place() == place;
+        }))};
+    if (number_of_players > 0) {
+      return number_of_players;
     } else {
       error("Place '" + place.print()
             + "' is not on any team for the game played on " + date_.print()
@@ -76,81 +100,72 @@ public:
   }
 
   bool exists(const PlayerName& player_name) const noexcept {
-    return player_names_.find(player_name) != player_names_.cend();
+    return find(player_name) != nullptr;
   }
 
   bool exists(const FactionName faction_name) const noexcept {
-    return faction_names_.find(faction_name) != faction_names_.cend();
+    return faction_names_.test(static_cast<std::size_t>(faction_name));
   }
 
   std::optional<Place> place(const PlayerName& player_name) const noexcept {
-    const std::map<PlayerName, Place, PlayerName::sort>::const_iterator found{
-        player_names_to_places_.find(player_name)};
-    if (found != player_names_to_places_.cend()) {
-      return {found->second};
+    const Participant* const participant{find(player_name)};
+    if (participant != nullptr) {
+      return {participant->place()};
     } else {
       const std::optional<Place> no_data;
       return no_data;
     }
   }
 
-  std::set<Place, Place::sort> places(
+  /// \brief Distinct places of a faction in this game, sorted from best to
+  /// worst. A faction can have several places because the Custom faction can
+  /// appear multiple times.
+  StaticVector<Place, MaximumNumberOfParticipants> places(
       const FactionName faction_name) const noexcept {
-    std::set<Place, Place::sort> places;
-    const std::pair<std::multimap<FactionName, Place,
-                                  std::less<FactionName>>::const_iterator,
-                    std::multimap<FactionName, Place,
-                                  std::less<FactionName>>::const_iterator>
-        range{faction_names_to_places_.equal_range(faction_name)};
-    for (std::multimap<FactionName, Place,
-                       std::less<FactionName>>::const_iterator i = range.first;
-         i != range.second; ++i) {
-      places.insert(i->second);
+    StaticVector<Place, MaximumNumberOfParticipants> places;
+    // The participants are sorted by place.
+    for (const Participant& participant : participants_) {
+      if (participant.faction_name() == faction_name
+          && (places.empty() || places.back() != participant.place())) {
+        places.push_back(participant.place());
+      }
     }
     return places;
   }
 
-  std::set<PlayerName> player_names(
+  StaticVector<PlayerName, MaximumNumberOfParticipants> player_names(
       const FactionName faction_name) const noexcept {
-    std::set<PlayerName> player_names;
-    const std::pair<std::multimap<FactionName, PlayerName,
-                                  std::less<FactionName>>::const_iterator,
-                    std::multimap<FactionName, PlayerName,
-                                  std::less<FactionName>>::const_iterator>
-        range{faction_names_to_player_names_.equal_range(faction_name)};
-    for (std::multimap<FactionName, PlayerName,
-                       std::less<FactionName>>::const_iterator i = range.first;
-         i != range.second; ++i) {
-      player_names.insert(i->second);
+    StaticVector<PlayerName, MaximumNumberOfParticipants> player_names;
+    for (const Participant& participant : participants_) {
+      if (participant.faction_name() == faction_name) {
+        player_names.push_back(participant.player_name());
+      }
     }
     return player_names;
   }
 
   std::optional<VictoryPoints> raw_victory_points(
       const PlayerName& player_name) const noexcept {
-    const std::map<PlayerName, VictoryPoints, PlayerName::sort>::const_iterator
-        found{player_names_to_victory_points_.find(player_name)};
-    if (found != player_names_to_victory_points_.cend()) {
-      return {found->second};
+    const Participant* const participant{find(player_name)};
+    if (participant != nullptr) {
+      return {participant->victory_points()};
     } else {
       const std::optional<VictoryPoints> no_data;
       return no_data;
     }
   }
 
-  std::multiset<VictoryPoints, VictoryPoints::sort> raw_victory_points(
+  /// \brief Victory points of each occurrence of a faction in this game,
+  /// sorted from most to fewest.
+  StaticVector<VictoryPoints, MaximumNumberOfParticipants> raw_victory_points(
       const FactionName faction_name) const noexcept {
-    std::multiset<VictoryPoints, VictoryPoints::sort> victory_points;
-    const std::pair<std::multimap<FactionName, VictoryPoints,
-                                  std::less<FactionName>>::const_iterator,
-                    std::multimap<FactionName, VictoryPoints,
-                                  std::less<FactionName>>::const_iterator>
-        range{faction_names_to_victory_points_.equal_range(faction_name)};
-    for (std::multimap<FactionName, VictoryPoints,
-                       std::less<FactionName>>::const_iterator i = range.first;
-         i != range.second; ++i) {
-      victory_points.insert(i->second);
+    StaticVector<VictoryPoints, MaximumNumberOfParticipants> victory_points;
+    for (const Participant& participant : participants_) {
+      if (participant.faction_name() == faction_name) {
+        victory_points.push_back(participant.victory_points());
+      }
     }
+    victory_points.sort(VictoryPoints::sort());
     return victory_points;
   }
 
@@ -159,38 +174,31 @@ public:
     const std::optional<VictoryPoints> raw_victory_points_{
         raw_victory_points(player_name)};
     if (raw_victory_points_.has_value()) {
-      const VictoryPoints limited_victory_points{
-          std::min(raw_victory_points_.value(), victory_point_goal_)};
-      return static_cast<double>(limited_victory_points.value())
-             / static_cast<double>(victory_point_goal_.value()) * 10.0;
+      return adjusted(raw_victory_points_.value());
     } else {
       const std::optional<double> no_data;
       return no_data;
     }
   }
 
-  std::multiset<double, std::greater<double>> adjusted_victory_points(
+  /// \brief Adjusted victory points of each occurrence of a faction in this
+  /// game, sorted from most to fewest.
+  StaticVector<double, MaximumNumberOfParticipants> adjusted_victory_points(
       const FactionName faction_name) const noexcept {
-    const std::multiset<VictoryPoints, VictoryPoints::sort>
-        raw_victory_points_multiset{raw_victory_points(faction_name)};
-    std::multiset<double, std::greater<double>> adjusted_victory_points_;
+    StaticVector<double, MaximumNumberOfParticipants> adjusted_victory_points_;
     for (const VictoryPoints& raw_victory_points :
-         raw_victory_points_multiset) {
-      const VictoryPoints limited_victory_points{
-          std::min(raw_victory_points, victory_point_goal_)};
-      adjusted_victory_points_.insert(
-          static_cast<double>(limited_victory_points.value())
-          / static_cast<double>(victory_point_goal_.value()) * 10.0);
+         raw_victory_points(faction_name)) {
+      adjusted_victory_points_.push_back(adjusted(raw_victory_points));
     }
+    adjusted_victory_points_.sort(std::greater<double>());
     return adjusted_victory_points_;
   }
 
   std::optional<FactionName> faction_name(
       const PlayerName& player_name) const noexcept {
-    const std::map<PlayerName, FactionName, PlayerName::sort>::const_iterator
-        found{player_names_to_faction_names_.find(player_name)};
-    if (found != player_names_to_faction_names_.cend()) {
-      return {found->second};
+    const Participant* const participant{find(player_name)};
+    if (participant != nullptr) {
+      return {participant->faction_name()};
     } else {
       const std::optional<FactionName> no_data;
       return no_data;
@@ -232,161 +240,113 @@ private:
   /// \brief Participants in this game.
   Participants participants_;
 
-  /// \brief Teams in this game.
-  std::set<Team, Team::sort> teams_;
-
-  /// \brief Set of player names. Player names are unique.
-  std::set<PlayerName, PlayerName::sort> player_names_;
-
-  /// \brief Place of each player name.
-  std::map<PlayerName, Place, PlayerName::sort> player_names_to_places_;
-
-  /// \brief Victory points of each player name.
-  std::map<PlayerName, VictoryPoints, PlayerName::sort>
-      player_names_to_victory_points_;
+  /// \brief Set of faction names in this game, indexed by faction name.
+  std::bitset<NumberOfFactionNames> faction_names_;
 
-  /// \brief Faction name of each player name.
-  std::map<PlayerName, FactionName, PlayerName::sort>
-      player_names_to_faction_names_;
+  uint64_t fingerprint_{0};
 
-  /// \brief Set of faction names. A multiset is used because the Custom faction
-  /// can appear multiple times.
-  std::multiset<FactionName, std::less<FactionName>> faction_names_;
-
-  /// \brief Set of places of each faction name. A multimap is used because the
-  /// Custom faction can appear multiple times.
-  std::multimap<FactionName, Place, std::less<FactionName>>
-      faction_names_to_places_;
-
-  /// \brief Set of player names of each faction name. A multimap is used
-  /// because the Custom faction can appear multiple times.
-  std::multimap<FactionName, PlayerName, std::less<FactionName>>
-      faction_names_to_player_names_;
+  /// \brief Participant with a given player name, or a null pointer if there
+  /// is no such participant. Player names are unique within a game.
+  const Participant* find(const PlayerName& player_name) const noexcept {
+    for (const Participant& participant : participants_) {
+      if (participant.player_name() == player_name) {
+        return &participant;
+      }
+    }
+    return nullptr;
+  }
 
-  /// \brief Set of victory points of each faction name. A multimap is used
-  /// because the Custom faction can appear multiple times.
-  std::multimap<FactionName, VictoryPoints, std::less<FactionName>>
-      faction_names_to_victory_points_;
+  /// \brief Victory points adjusted relative to a 10-point game. Victory
+  /// points beyond the victory point goal are not counted.
+  double adjusted(const VictoryPoints& raw_victory_points) const noexcept {
+    const VictoryPoints limited_victory_points{
+        std::min(raw_victory_points, victory_point_goal_)};
+    return static_cast<double>(limited_victory_points.value())
+           / static_cast<double>(victory_point_goal_.value()) * 10.0;
+  }
 
-  void initialize_header(const std::string& line) {
+  void initialize_header(const std::string_view line) {
     // The line is expected to read: "<date> <game-mode> <victory-points-goal>
     // <duration>" The duration is optional.
-    const std::vector<std::string> words{split_by_whitespace(line)};
+    const std::vector<std::string_view> words{split_by_whitespace(line)};
     if (words.size() == 3 || words.size() == 4) {
-      date_ = {words[0]};
-      const std::optional<GameMode> optional_mode{type<GameMode>(words[1])};
+      date_ = {std::string{words[0]}};
+      const std::optional<GameMode> optional_mode{
+          type<GameMode>(std::string{words[1]})};
       if (!optional_mode.has_value()) {
-        error("'" + words[2]
+        error("'" + std::string{words[2]}
               + "' is not a valid game mode for the game played on "
               + date_.print() + ".");
       }
       mode_ = optional_mode.value();
-      victory_point_goal_ = {words[2]};
+      victory_point_goal_ = {std::string{words[2]}};
       if (victory_point_goal_ <= VictoryPoints{0}) {
         error("'" + victory_point_goal_.print()
               + "' is not a valid victory point goal for the game played on "
               + date_.print() + ".");
       }
       if (words.size() == 4) {
-        duration_ = {words[3]};
+        duration_ = {std::string{words[3]}};
       }
     } else {
-      error("'" + line + "' does not contain a date, a game mode, a number of victory points, and an optional duration.");
+      error("'" + std::string{line} + "' does not contain a date, a game mode, a number of victory points, and an optional duration.");
     }
   }
 
-  void initialize_player(const std::string& line) {
+  void initialize_player(const std::string_view line) {
     // The line is expected to read: "<place> <player-name> <victory-points>
     // <faction>""
-    const std::vector<std::string> words{parse_participant(line)};
+    const std::vector<std::string_view> words{parse_participant(line)};
     if (words.size() == 4) {
-      const Place place{words[0]};
-      const PlayerName player_name{words[1]};
-      const VictoryPoints victory_points{words[2]};
+      const Place place{std::string{words[0]}};
+      const PlayerName player_name{std::string{words[1]}};
+      const VictoryPoints victory_points{std::string{words[2]}};
       const std::optional<FactionName> optional_faction_name{
-          type<FactionName>(words[3])};
+          type<FactionName>(std::string{words[3]})};
       if (!optional_faction_name.has_value()) {
-        error("'" + words[3]
+        error("'" + std::string{words[3]}
               + "' is not a valid faction for the game played on "
               + date_.print() + ".");
       }
+      if (exists(player_name)) {
+        error("Player '" + player_name.value()
+              + "' appears twice in the game played on " + date_.print() + ".");
+      }
       participants_.emplace(
           place, player_name, victory_points, optional_faction_name.value());
-      update_teams(place, player_name);
-      initialize_player_names(
-          place, player_name, victory_points, optional_faction_name.value());
-      initialize_faction_names(
-          place, player_name, victory_points, optional_faction_name.value());
+      faction_names_.set(
+          static_cast<std::size_t>(optional_faction_name.value()));
     } else {
-      error("'" + line + "' does not contain a place, player, number of victory points, and faction for the game played on " + date_.print() + ".");
+      error("'" + std::string{line} + "' does not contain a place, player, number of victory points, and faction for the game played on " + date_.print() + ".");
     }
   }
 
-  std::vector<std::string> parse_participant(
-      const std::string& line) const noexcept {
+  std::vector<std::string_view> parse_participant(
+      const std::string_view line) const noexcept {
     // Expect any number of whitespace characters delimiting the place, player
     // name, number of victory points, and faction name. However, expect the
     // words of the faction name to be separated by only a single space.
-    std::vector<std::string> words;
-    std::string word;
-    for (const char c : line) {
-      if (::isspace(c) && words.size() < 3) {
-        if (!word.empty()) {
-          words.push_back(word);
-          word.clear();
+    std::vector<std::string_view> words;
+    std::size_t word_start{0};
+    std::size_t word_length{0};
+    for (std::size_t index = 0; index < line.size(); ++index) {
+      if (::isspace(line[index]) && words.size() < 3) {
+        if (word_length > 0) {
+          words.push_back(line.substr(word_start, word_length));
+          word_length = 0;
         }
       } else {
-        word.push_back(c);
+        if (word_length == 0) {
+          word_start = index;
+        }
+        ++word_length;
       }
     }
-    words.push_back(word);
+    words.push_back(line.substr(word_start, word_length));
     return words;
   }
 
-  void update_teams(
-      const Place& place, const PlayerName& player_name) noexcept {
-    const std::set<Team, Team::sort>::const_iterator team{teams_.find({place})};
-    if (team != teams_.end()) {
-      if (team->exists(player_name)) {
-        error("Player '" + player_name.value() + "' is already on team '"
-              + team->print() + "'.");
-      } else {
-        Team updated_team{*team};
-        updated_team.insert(player_name);
-        teams_.erase(team);
-        teams_.insert(updated_team);
-      }
-    } else {
-      teams_.emplace(place, player_name);
-    }
-  }
-
-  void initialize_player_names(
-      const Place& place, const PlayerName& player_name,
-      const VictoryPoints& victory_points, const FactionName faction_name) {
-    const std::pair<std::set<PlayerName, PlayerName::sort>::const_iterator,
-                    bool>
-        result{player_names_.insert(player_name)};
-    if (!result.second) {
-      error("Player '" + player_name.value()
-            + "' appears twice in the game played on " + date_.print() + ".");
-    }
-    player_names_to_places_.emplace(player_name, place);
-    player_names_to_victory_points_.emplace(player_name, victory_points);
-    player_names_to_faction_names_.emplace(player_name, faction_name);
-  }
-
-  void initialize_faction_names(
-      const Place& place, const PlayerName& player_name,
-      const VictoryPoints& victory_points,
-      const FactionName faction_name) noexcept {
-    faction_names_.insert(faction_name);
-    faction_names_to_places_.emplace(faction_name, place);
-    faction_names_to_player_names_.emplace(faction_name, player_name);
-    faction_names_to_victory_points_.emplace(faction_name, victory_points);
-  }
-
-  void check_mode() noexcept {
+  void check_mode() {
     switch (mode_) {
       case GameMode::FreeForAll:
         check_mode_free_for_all();
@@ -399,7 +359,7 @@ private:
   }
 
   /// \brief In free-for-all games, each player must have a unique place.
-  void check_mode_free_for_all() const noexcept {
+  void check_mode_free_for_all() const {
     std::set<Place, Place::sort> places;
     for (const Participant& participant : participants_) {
       const std::pair<std::set<Place, Place::sort>::const_iterator, bool>
@@ -412,6 +372,11 @@ private:
     }
   }
 
+  void initialize_fingerprint(
+      const std::vector<std::string_view>& lines) noexcept {
+    fingerprint_ = fingerprint(lines);
+  }
+
 };  // class Game
 
 }  // namespace TI4Echelon
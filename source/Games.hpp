@@ -1,42 +1,180 @@
 #pragma once
 
 #include "GamesDurationVersusNumberOfPlayers.hpp"
-#include "TextFileReader.hpp"
+#include "MappedTextFileReader.hpp"
+#include "Profiler.hpp"
 
 namespace TI4Echelon {
 
-/// \brief List of games read from the games file.
+/// \brief List of games read from the games file. The games are iterated from
+/// most recent to oldest, or from oldest to most recent with the reverse
+/// iterators.
 class Games {
 public:
-  Games(const std::filesystem::path& games_file_path) {
+  /// \brief Default constructor. Initializes an empty list of games, to which
+  /// games can then be appended.
+  Games() noexcept {}
+
+  /// \brief Reads and parses the games file. The games are independent of one
+  /// another, so they are parsed in parallel using up to a given number of
+  /// threads. The results do not depend on the number of threads.
+  Games(const std::filesystem::path& games_file_path,
+        const std::size_t number_of_threads = 1) {
+    const ProfilerScope profiler_scope{"Read the games file"};
     message("Reading the games file...");
-    const TextFileReader games_file_reader{games_file_path};
-    std::vector<std::string> game_lines;
-    for (const std::string& line : games_file_reader) {
-      if (line.empty()) {
-        if (!game_lines.empty()) {
-          data_.emplace_back(game_lines);
-          duration_versus_number_of_players_.insert(data_.back());
-        }
-        game_lines.clear();
-      } else {
-        game_lines.push_back(line);
+    const MappedTextFileReader games_file_reader{games_file_path};
+    const std::vector<Block> blocks_{blocks(games_file_reader)};
+    data_ = parse(games_file_reader, blocks_, number_of_threads);
+    sort_chronologically(data_);
+    for (std::size_t index = 0; index < data_.size(); ++index) {
+      data_[index].set_index(index);
+      duration_versus_number_of_players_.insert(data_[index]);
+    }
+    if (console_messages()) {
+      message("Read " + std::to_string(data_.size())
+              + " games from the games file:");
+      for (const Game& game : *this) {
+        message("- " + game.print() + ".");
       }
     }
-    if (!game_lines.empty()) {
-      data_.emplace_back(game_lines);
-      duration_versus_number_of_players_.insert(data_.back());
+  }
+
+  /// \brief Appends a game played no earlier than the most recent game. The
+  /// game is given the next chronological index, and its duration, if any, is
+  /// inserted into the linear regression of the durations. Returns the
+  /// appended game, which can then be applied to the players and factions.
+  const Game& append(Game game) {
+    if (!data_.empty() && game.date() < data_.back().date()) {
+      error("The game '" + game.print()
+            + "' cannot be appended because it is older than the most recent "
+              "game.");
     }
-    std::sort(data_.begin(), data_.end(), Game::sort());
+    game.set_index(data_.size());
+    duration_versus_number_of_players_.insert(game);
+    data_.push_back(std::move(game));
+    return data_.back();
+  }
+
+  /// \brief Reads the games file again after it changed. Only the blocks that
+  /// do not match the lines of any current game are parsed, and the current
+  /// games whose lines no longer appear in the file are removed. The games
+  /// after the earliest game that changed are given new indices. Returns the
+  /// index of that game, from which the players and factions must be
+  /// corrected, or no value if the chronological order of the games did not
+  /// change. If the file cannot be parsed, the games are left unchanged.
+  std::optional<std::size_t> update(
+      const std::filesystem::path& games_file_path,
+      const std::size_t number_of_threads = 1) {
+    const ProfilerScope profiler_scope{"Update the games"};
+    const MappedTextFileReader games_file_reader{games_file_path};
+    const std::vector<Block> blocks_{blocks(games_file_reader)};
+    std::unordered_multimap<uint64_t, std::size_t> current_indices;
     for (std::size_t index = 0; index < data_.size(); ++index) {
-      data_[index].set_index(data_.size() - 1 - index);
+      current_indices.emplace(data_[index].fingerprint(), index);
+    }
+    // Index of the current game that matches each block, or the number of
+    // current games if the block is new.
+    std::vector<std::size_t> matching_indices(blocks_.size(), data_.size());
+    std::vector<Block> new_blocks;
+    std::vector<std::string_view> lines;
+    for (std::size_t index = 0; index < blocks_.size(); ++index) {
+      lines.assign(games_file_reader.cbegin() + blocks_[index].first_line_index,
+                   games_file_reader.cbegin() + blocks_[index].end_line_index);
+      const std::unordered_multimap<uint64_t, std::size_t>::const_iterator
+          current{current_indices.find(Game::fingerprint(lines))};
+      if (current != current_indices.cend()) {
+        matching_indices[index] = current->second;
+        current_indices.erase(current);
+      } else {
+        new_blocks.push_back(blocks_[index]);
+      }
     }
-    duration_versus_number_of_players_.initialize_linear_regression();
-    message(
-        "Read " + std::to_string(data_.size()) + " games from the games file:");
-    for (const Game& game : data_) {
+    std::vector<Game> new_games{
+        parse(games_file_reader, new_blocks, number_of_threads)};
+    message("Read " + std::to_string(new_games.size())
+            + " new or edited games from the games file and removed "
+            + std::to_string(current_indices.size())
+            + (new_games.empty() ? " games." : " games:"));
+    for (const Game& game : new_games) {
       message("- " + game.print() + ".");
     }
+    std::vector<Game> games;
+    games.reserve(blocks_.size());
+    std::vector<Game>::iterator new_game{new_games.begin()};
+    for (const std::size_t matching_index : matching_indices) {
+      if (matching_index < data_.size()) {
+        games.push_back(std::move(data_[matching_index]));
+      } else {
+        games.push_back(std::move(*new_game));
+        ++new_game;
+      }
+    }
+    sort_chronologically(games);
+    std::size_t first_changed_index{0};
+    while (first_changed_index < std::min(games.size(), data_.size())
+           && games[first_changed_index].fingerprint()
+                  == data_[first_changed_index].fingerprint()) {
+      ++first_changed_index;
+    }
+    const bool changed{games.size() != data_.size()
+                       || first_changed_index < games.size()};
+    data_ = std::move(games);
+    if (!changed) {
+      return std::nullopt;
+    }
+    reindex(first_changed_index);
+    return first_changed_index;
+  }
+
+  /// \brief Removes the games played after a given date, such that the
+  /// statistics are computed as of that date.
+  void erase_after(const Date& date) noexcept {
+    const std::vector<Game>::iterator first_erased{std::upper_bound(
+        data_.begin(), data_.end(), date,
+        [](const Date& date_, const Game& game) {
+          return date_ < game.date();
+        })};
+    const std::size_t size_{
+        static_cast<std::size_t>(first_erased - data_.begin())};
+    if (size_ < data_.size()) {
+      data_.erase(first_erased, data_.end());
+      reindex(size_);
+    }
+  }
+
+  /// \brief Inserts a past game, such as one that was missing from the games
+  /// file, after the games played on the same date or earlier. The games after
+  /// it are given new indices. Returns the index of the inserted game, which is
+  /// the index of the earliest game that changed, from which the players and
+  /// factions must be corrected.
+  std::size_t insert(Game game) noexcept {
+    const std::size_t index{place(std::move(game))};
+    reindex(index);
+    return index;
+  }
+
+  /// \brief Removes the game with a given index, such as one that was entered
+  /// by mistake. The games after it are given new indices. Returns the index of
+  /// the earliest game that changed, from which the players and factions must
+  /// be corrected.
+  std::size_t erase(const std::size_t index) {
+    check_index(index);
+    data_.erase(data_.begin() + static_cast<std::ptrdiff_t>(index));
+    reindex(index);
+    return index;
+  }
+
+  /// \brief Replaces the game with a given index by a corrected version of it.
+  /// If the date of the game changed, the corrected game moves to its new
+  /// chronological position. Returns the index of the earliest game that
+  /// changed, from which the players and factions must be corrected.
+  std::size_t replace(const std::size_t index, Game game) {
+    check_index(index);
+    data_.erase(data_.begin() + static_cast<std::ptrdiff_t>(index));
+    const std::size_t first_changed_index{
+        std::min(index, place(std::move(game)))};
+    reindex(first_changed_index);
+    return first_changed_index;
   }
 
   const GamesDurationVersusNumberOfPlayers&
@@ -44,18 +182,34 @@ public:
     return duration_versus_number_of_players_;
   }
 
-  struct const_iterator : public std::vector<Game>::const_iterator {
-    const_iterator(const std::vector<Game>::const_iterator i) noexcept
-      : std::vector<Game>::const_iterator(i) {}
-  };
+  /// \brief Hash of the fingerprints of a given number of the oldest games, in
+  /// chronological order. Two games files whose oldest games are the same have
+  /// the same fingerprint for that number of games.
+  uint64_t fingerprint(const std::size_t number_of_games) const noexcept {
+    uint64_t hash{content_hash("")};
+    for (std::size_t index = 0;
+         index < std::min(number_of_games, data_.size()); ++index) {
+      const uint64_t game_fingerprint{data_[index].fingerprint()};
+      hash = content_hash(
+          {reinterpret_cast<const char*>(&game_fingerprint),
+           sizeof(game_fingerprint)},
+          hash);
+    }
+    return hash;
+  }
 
-  struct const_reverse_iterator
-    : public std::vector<Game>::const_reverse_iterator {
-    const_reverse_iterator(
-        const std::vector<Game>::const_reverse_iterator i) noexcept
+  /// \brief Iterates from the most recent game to the oldest game.
+  struct const_iterator : public std::vector<Game>::const_reverse_iterator {
+    const_iterator(const std::vector<Game>::const_reverse_iterator i) noexcept
       : std::vector<Game>::const_reverse_iterator(i) {}
   };
 
+  /// \brief Iterates from the oldest game to the most recent game.
+  struct const_reverse_iterator : public std::vector<Game>::const_iterator {
+    const_reverse_iterator(const std::vector<Game>::const_iterator i) noexcept
+      : std::vector<Game>::const_iterator(i) {}
+  };
+
   bool empty() const noexcept {
     return data_.empty();
   }
@@ -65,44 +219,182 @@ public:
   }
 
   const_iterator begin() const noexcept {
-    return const_iterator(data_.begin());
+    return const_iterator(data_.crbegin());
   }
 
   const_iterator cbegin() const noexcept {
-    return const_iterator(data_.cbegin());
+    return const_iterator(data_.crbegin());
   }
 
   const_reverse_iterator rbegin() const noexcept {
-    return const_reverse_iterator(data_.rbegin());
+    return const_reverse_iterator(data_.cbegin());
   }
 
   const_reverse_iterator crbegin() const noexcept {
-    return const_reverse_iterator(data_.crbegin());
+    return const_reverse_iterator(data_.cbegin());
   }
 
   const_iterator end() const noexcept {
-    return const_iterator(data_.end());
+    return const_iterator(data_.crend());
   }
 
   const_iterator cend() const noexcept {
-    return const_iterator(data_.cend());
+    return const_iterator(data_.crend());
   }
 
   const_reverse_iterator rend() const noexcept {
-    return const_reverse_iterator(data_.rend());
+    return const_reverse_iterator(data_.cend());
   }
 
   const_reverse_iterator crend() const noexcept {
-    return const_reverse_iterator(data_.crend());
+    return const_reverse_iterator(data_.cend());
   }
 
 private:
+  /// \brief Range of lines of the games file that make up a single game. The
+  /// lines are indexed from zero.
+  struct Block {
+    std::size_t first_line_index;
+
+    std::size_t end_line_index;
+  };
+
   GamesDurationVersusNumberOfPlayers duration_versus_number_of_players_;
 
-  /// \brief Sorted in reverse-chronological order, i.e. from most recent to
-  /// oldest.
+  /// \brief Sorted in chronological order, i.e. from oldest to most recent,
+  /// such that a new game is appended at the end. The index of each game is its
+  /// position in this list.
   std::vector<Game> data_;
 
+  /// \brief Sorts games parsed in the order of the games file from oldest to
+  /// most recent. Games played on the same date keep their order in the games
+  /// file, such that the chronological order of a set of games does not change
+  /// when other games are added to the file. Games files can list the games
+  /// either from most recent to oldest or from oldest to most recent. The
+  /// direction is found from the first game played on a different date than
+  /// the first game of the file. If all games were played on the same date,
+  /// they are taken to be listed from oldest to most recent.
+  static void sort_chronologically(std::vector<Game>& games) noexcept {
+    const std::vector<Game>::const_iterator first_other_date{std::find_if(
+        games.cbegin(), games.cend(), [&games](const Game& game) {
+          return game.date() != games.front().date();
+        })};
+    if (first_other_date == games.cend()
+        || games.front().date() < first_other_date->date()) {
+      std::reverse(games.begin(), games.end());
+    }
+    std::stable_sort(games.begin(), games.end(), Game::sort());
+    std::reverse(games.begin(), games.end());
+  }
+
+  void check_index(const std::size_t index) const {
+    if (index >= data_.size()) {
+      error("There is no game with index " + std::to_string(index) + ".");
+    }
+  }
+
+  /// \brief Places a game after the games played on the same date or earlier,
+  /// without updating the indices. Returns the position of the game.
+  std::size_t place(Game game) noexcept {
+    const std::vector<Game>::iterator position{std::upper_bound(
+        data_.begin(), data_.end(), game,
+        [](const Game& game_1, const Game& game_2) {
+          return game_1.date() < game_2.date();
+        })};
+    return static_cast<std::size_t>(
+        data_.insert(position, std::move(game)) - data_.begin());
+  }
+
+  /// \brief Updates the indices of the games from a given index onwards, and
+  /// inserts their durations again from the latest periodic checkpoint of the
+  /// durations taken no later than that index.
+  void reindex(const std::size_t first_changed_index) noexcept {
+    for (std::size_t index = first_changed_index; index < data_.size();
+         ++index) {
+      data_[index].set_index(index);
+    }
+    duration_versus_number_of_players_.roll_back(first_changed_index);
+    for (std::size_t index =
+             duration_versus_number_of_players_.number_of_games();
+         index < data_.size(); ++index) {
+      duration_versus_number_of_players_.insert(data_[index]);
+    }
+  }
+
+  /// \brief Splits the games file into blocks of consecutive non-empty lines.
+  /// Games are separated by one or more empty lines.
+  static std::vector<Block> blocks(
+      const MappedTextFileReader& reader) noexcept {
+    std::vector<Block> blocks_;
+    std::size_t index{0};
+    std::optional<std::size_t> first_line_index;
+    for (const std::string_view line : reader) {
+      if (line.empty()) {
+        if (first_line_index.has_value()) {
+          blocks_.push_back({first_line_index.value(), index});
+          first_line_index.reset();
+        }
+      } else if (!first_line_index.has_value()) {
+        first_line_index = index;
+      }
+      ++index;
+    }
+    if (first_line_index.has_value()) {
+      blocks_.push_back({first_line_index.value(), index});
+    }
+    return blocks_;
+  }
+
+  /// \brief Parses each block as a game. The blocks are divided into
+  /// contiguous ranges, each of which is parsed by its own thread. The games
+  /// are returned in the same order as the blocks. If any blocks cannot be
+  /// parsed, the error of the earliest such block is reported along with its
+  /// line number.
+  static std::vector<Game> parse(const MappedTextFileReader& reader,
+                                 const std::vector<Block>& blocks,
+                                 const std::size_t number_of_threads) {
+    std::vector<Game> games(blocks.size());
+    std::vector<std::string> errors(blocks.size());
+    const std::size_t number_of_workers{
+        std::max(static_cast<std::size_t>(1),
+                 std::min(number_of_threads, blocks.size()))};
+    const std::size_t blocks_per_worker{
+        (blocks.size() + number_of_workers - 1) / number_of_workers};
+    const auto parse_range{[&](const std::size_t begin, const std::size_t end) {
+      std::vector<std::string_view> lines;
+      for (std::size_t index = begin; index < end; ++index) {
+        lines.assign(reader.cbegin() + blocks[index].first_line_index,
+                     reader.cbegin() + blocks[index].end_line_index);
+        try {
+          games[index] = Game{lines};
+        } catch (const std::exception& exception) {
+          errors[index] = exception.what();
+        }
+      }
+    }};
+    std::vector<std::thread> workers;
+    for (std::size_t worker = 1; worker < number_of_workers; ++worker) {
+      const std::size_t begin{
+          std::min(worker * blocks_per_worker, blocks.size())};
+      const std::size_t end{std::min(begin + blocks_per_worker, blocks.size())};
+      workers.emplace_back(parse_range, begin, end);
+    }
+    parse_range(0, std::min(blocks_per_worker, blocks.size()));
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    for (std::size_t index = 0; index < blocks.size(); ++index) {
+      if (!errors[index].empty()) {
+        error("Could not parse the game starting on line "
+              + std::to_string(blocks[index].first_line_index + 1) + " of '"
+              + reader.path().string() + "': " + errors[index]);
+      }
+    }
+    // From now on, the player names are compared by their alphabetical rank.
+    PlayerNameRegistry::get().rank();
+    return games;
+  }
+
 };  // class Games
 
 }  // namespace TI4Echelon
@@ -3,6 +3,7 @@
 #include "Duration.hpp"
 #include "Game.hpp"
 #include "LinearRegression.hpp"
+#include "PeriodicCheckpoints.hpp"
 
 namespace TI4Echelon {
 
@@ -29,10 +30,28 @@ public:
            + " * players";
   }
 
+  /// \brief Number of games inserted so far, with or without a duration.
+  std::size_t number_of_games() const noexcept {
+    return number_of_games_;
+  }
+
+  /// \brief Inserts the duration of a game, if it has one, and updates the
+  /// linear regression. Games must be inserted in chronological order.
   void insert(const Game& game) noexcept {
+    if (periodic_checkpoints_.due(number_of_games_)) {
+      periodic_checkpoints_.record(
+          number_of_games_,
+          {number_of_players_and_duration_in_hours_.size(),
+           minimum_duration_in_hours_, maximum_duration_in_hours_,
+           linear_regression_});
+    }
+    ++number_of_games_;
     if (game.duration().has_value()) {
       number_of_players_and_duration_in_hours_.emplace_back(
           game.participants().size(), game.duration().value().hours());
+      linear_regression_.insert(
+          number_of_players_and_duration_in_hours_.back().first,
+          number_of_players_and_duration_in_hours_.back().second);
       if (game.duration().value().hours() < minimum_duration_in_hours_) {
         minimum_duration_in_hours_ = game.duration().value().hours();
       }
@@ -42,8 +61,25 @@ public:
     }
   }
 
-  void initialize_linear_regression() noexcept {
-    linear_regression_ = {number_of_players_and_duration_in_hours_};
+  /// \brief Rolls back to the latest periodic checkpoint taken no later than
+  /// the game with a given index, or to before the first game if there is no
+  /// such checkpoint. The games from the number of games at that point onwards
+  /// must then be inserted again.
+  void roll_back(const std::size_t game_index) noexcept {
+    const PeriodicCheckpoints<PeriodicCheckpoint>::Record* const checkpoint{
+        periodic_checkpoints_.rewind(game_index)};
+    if (checkpoint != nullptr) {
+      number_of_games_ = checkpoint->first;
+      number_of_players_and_duration_in_hours_.resize(
+          checkpoint->second->number_of_durations);
+      minimum_duration_in_hours_ =
+          checkpoint->second->minimum_duration_in_hours;
+      maximum_duration_in_hours_ =
+          checkpoint->second->maximum_duration_in_hours;
+      linear_regression_ = checkpoint->second->linear_regression;
+    } else {
+      *this = GamesDurationVersusNumberOfPlayers{};
+    }
   }
 
   struct const_iterator
@@ -115,6 +151,29 @@ private:
 
   LinearRegression linear_regression_;
 
+  std::size_t number_of_games_{0};
+
+  struct PeriodicCheckpoint {
+    std::size_t number_of_durations{0};
+
+    double minimum_duration_in_hours{10.0};
+
+    double maximum_duration_in_hours{0.0};
+
+    LinearRegression linear_regression;
+
+    /// \brief Checkpoint that replaces a checkpoint and the previous one,
+    /// given the previous one first. Each checkpoint holds the whole state, so
+    /// this is the later checkpoint.
+    static PeriodicCheckpoint merge(
+        const PeriodicCheckpoint&,
+        const PeriodicCheckpoint& checkpoint) noexcept {
+      return checkpoint;
+    }
+  };
+
+  PeriodicCheckpoints<PeriodicCheckpoint> periodic_checkpoints_;
+
 };  // class GamesDurationVersusNumberOfPlayers
 
 }  // namespace TI4Echelon
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "Base.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Time in milliseconds during which the games file must not change
+/// before a change is reported, such that a file written in several steps is
+/// only read once it is complete.
+constexpr const int GamesFileSettleMilliseconds{200};
+
+/// \brief Watches the games file for changes using inotify.
+/// \details The directory that contains the games file is watched rather than
+/// the file itself, such that a change is also detected when the file is
+/// replaced by another one, as many editors do when saving a file.
+class GamesFileWatcher {
+public:
+  GamesFileWatcher(const std::filesystem::path& games_file_path)
+    : file_name_(games_file_path.filename().string()) {
+    const std::filesystem::path directory{
+        games_file_path.has_parent_path() ? games_file_path.parent_path() :
+                                            std::filesystem::path{"."}};
+    descriptor_ = ::inotify_init1(IN_CLOEXEC);
+    if (descriptor_ < 0) {
+      error("Could not initialize the watch of the games file: "
+            + games_file_path.string());
+    }
+    if (::inotify_add_watch(descriptor_, directory.c_str(),
+                            IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO)
+        < 0) {
+      ::close(descriptor_);
+      error("Could not watch the directory: " + directory.string());
+    }
+  }
+
+  GamesFileWatcher(const GamesFileWatcher&) = delete;
+
+  GamesFileWatcher& operator=(const GamesFileWatcher&) = delete;
+
+  ~GamesFileWatcher() noexcept {
+    ::close(descriptor_);
+  }
+
+  /// \brief Blocks until the games file changes and then stops changing for
+  /// GamesFileSettleMilliseconds.
+  void wait() {
+    while (!read_events(-1)) {}
+    while (read_events(GamesFileSettleMilliseconds)) {}
+  }
+
+private:
+  std::string file_name_;
+
+  int descriptor_{-1};
+
+  /// \brief Waits for events for up to a given number of milliseconds, or
+  /// indefinitely if the number is negative, and reads them. Returns whether
+  /// any of them concerns the games file.
+  bool read_events(const int timeout_milliseconds) {
+    pollfd poll_descriptor{descriptor_, POLLIN, 0};
+    const int ready{::poll(&poll_descriptor, 1, timeout_milliseconds)};
+    if (ready < 0 && errno != EINTR) {
+      error("Could not wait for changes to the games file.");
+    }
+    if (ready <= 0) {
+      return false;
+    }
+    alignas(inotify_event) char buffer[4096];
+    const ssize_t length{::read(descriptor_, buffer, sizeof(buffer))};
+    if (length < 0) {
+      if (errno == EINTR || errno == EAGAIN) {
+        return false;
+      }
+      error("Could not read the changes to the games file.");
+    }
+    bool changed{false};
+    for (ssize_t offset = 0; offset < length;) {
+      const inotify_event* const event{
+          reinterpret_cast<const inotify_event*>(buffer + offset)};
+      if (event->len > 0 && file_name_ == event->name) {
+        changed = true;
+      }
+      offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+    }
+    return changed;
+  }
+
+};  // class GamesFileWatcher
+
+}  // namespace TI4Echelon
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "Date.hpp"
+#include "Duration.hpp"
+#include "FactionName.hpp"
+#include "GameMode.hpp"
+#include "Participants.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Settings of the synthetic games generator.
+struct GamesGeneratorSettings {
+  std::size_t number_of_games{1000};
+
+  /// \brief Number of distinct players from which the participants of each
+  /// game are drawn.
+  std::size_t number_of_players{50};
+
+  /// \brief Exponent of the Zipf-like distribution of player activity. The
+  /// player with rank N is drawn with a weight of 1 / N^skew, so 0 draws all
+  /// players equally often.
+  double player_skew{0.0};
+
+  std::size_t minimum_number_of_participants{3};
+
+  std::size_t maximum_number_of_participants{MaximumNumberOfParticipants};
+
+  /// \brief Exponent of the Zipf-like distribution of faction popularity, in
+  /// the same way as the player skew. Factions are ranked alphabetically.
+  double faction_skew{0.0};
+
+  /// \brief Probability that a participant plays the Custom faction.
+  double custom_faction_probability{0.0};
+
+  /// \brief Probability that a game with an even number of participants is
+  /// played in teams of two rather than free-for-all.
+  double teams_probability{0.0};
+
+  /// \brief Victory point goals, one of which is drawn uniformly for each game.
+  std::vector<int64_t> victory_point_goals{10};
+
+  /// \brief Probability that a game records its duration.
+  double duration_probability{0.0};
+
+  /// \brief Games are spread evenly over the dates from the first date to the
+  /// last date, inclusive.
+  Date first_date{2000, 1, 1};
+
+  Date last_date{2009, 12, 31};
+
+  /// \brief Seed of the pseudo-random number generator. The same seed always
+  /// generates the same games.
+  uint64_t seed{0};
+};
+
+/// \brief Generator of synthetic games in the format of the games file.
+/// \details Used to benchmark and stress-test the program on data sets of any
+/// size. Each game draws its participants from the player pool, and each
+/// participant plays a distinct faction unless it plays the Custom faction.
+/// Games are listed in chronological order.
+class GamesGenerator {
+public:
+  GamesGenerator(const GamesGeneratorSettings& settings) : settings_(settings) {
+    check();
+  }
+
+  /// \brief Name of the player with a given index, such as "PlayerAAA". Player
+  /// names consist only of letters.
+  static std::string player_name(std::size_t index) noexcept {
+    std::string suffix;
+    do {
+      suffix.insert(suffix.begin(), static_cast<char>('A' + index % 26));
+      index /= 26;
+    } while (index > 0);
+    if (suffix.size() < 3) {
+      suffix.insert(0, 3 - suffix.size(), 'A');
+    }
+    return "Player" + suffix;
+  }
+
+  /// \brief Generates the games and writes them to a stream, separated by
+  /// blank lines, in the format of the games file.
+  void write(std::ostream& stream) const noexcept {
+    std::mt19937_64 engine{settings_.seed};
+    const std::vector<double> player_weights{
+        zipf_weights(settings_.number_of_players, settings_.player_skew)};
+    std::discrete_distribution<std::size_t> player_distribution{
+        player_weights.cbegin(), player_weights.cend()};
+    const std::vector<FactionName> factions{
+        FactionNames.cbegin(), FactionNames.cend()};
+    const std::vector<double> faction_weights{
+        zipf_weights(factions.size(), settings_.faction_skew)};
+    std::discrete_distribution<std::size_t> faction_distribution{
+        faction_weights.cbegin(), faction_weights.cend()};
+    std::uniform_int_distribution<std::size_t> number_of_participants{
+        settings_.minimum_number_of_participants,
+        settings_.maximum_number_of_participants};
+    std::uniform_int_distribution<std::size_t> goal_distribution{
+        0, settings_.victory_point_goals.size() - 1};
+    std::uniform_real_distribution<double> probability{0.0, 1.0};
+    const int64_t first_day{days(settings_.first_date)};
+    const int64_t number_of_days{days(settings_.last_date) - first_day + 1};
+    std::vector<std::size_t> players;
+    std::vector<FactionName> seated_factions;
+    std::vector<std::size_t> faction_indices;
+    for (std::size_t index = 0; index < settings_.number_of_games; ++index) {
+      const std::size_t size{number_of_participants(engine)};
+      const GameMode mode{
+          size % 2 == 0 && probability(engine) < settings_.teams_probability ?
+              GameMode::Teams :
+              GameMode::FreeForAll};
+      const int64_t goal{settings_.victory_point_goals[goal_distribution(
+          engine)]};
+      const int64_t day{
+          first_day
+          + static_cast<int64_t>(index) * number_of_days
+                / static_cast<int64_t>(settings_.number_of_games)};
+      stream << date(day).print() << " " << label(mode) << " " << goal;
+      if (probability(engine) < settings_.duration_probability) {
+        // Games take roughly an hour per player, give or take two hours.
+        std::uniform_int_distribution<int64_t> minutes{
+            static_cast<int64_t>(size) * 60 - 120,
+            static_cast<int64_t>(size) * 60 + 120};
+        stream << " " << Duration{minutes(engine)}.print();
+      }
+      stream << "\n";
+      players.clear();
+      while (players.size() < size) {
+        players.push_back(draw_distinct(engine, player_distribution,
+                                        settings_.player_skew, players));
+      }
+      seated_factions.clear();
+      faction_indices.clear();
+      while (seated_factions.size() < size) {
+        if (probability(engine) < settings_.custom_faction_probability) {
+          seated_factions.push_back(FactionName::Custom);
+          continue;
+        }
+        faction_indices.push_back(draw_distinct(engine, faction_distribution,
+                                                settings_.faction_skew,
+                                                faction_indices));
+        seated_factions.push_back(factions[faction_indices.back()]);
+      }
+      std::uniform_int_distribution<int64_t> victory_points{0, goal - 1};
+      for (std::size_t seat = 0; seat < size; ++seat) {
+        const std::size_t place{mode == GameMode::Teams ? seat / 2 : seat};
+        stream << Place{static_cast<int8_t>(place + 1)}.print() << " "
+               << player_name(players[seat]) << " "
+               << (place == 0 ? goal : victory_points(engine)) << " "
+               << label(seated_factions[seat]) << "\n";
+      }
+      stream << "\n";
+    }
+  }
+
+  /// \brief Generates the games as text in the format of the games file.
+  std::string print() const noexcept {
+    std::stringstream stream;
+    write(stream);
+    return stream.str();
+  }
+
+private:
+  GamesGeneratorSettings settings_;
+
+  void check() const {
+    if (settings_.minimum_number_of_participants < 2
+        || settings_.minimum_number_of_participants
+               > settings_.maximum_number_of_participants
+        || settings_.maximum_number_of_participants
+               > MaximumNumberOfParticipants) {
+      error("The number of participants per game must be between 2 and "
+            + std::to_string(MaximumNumberOfParticipants) + ".");
+    }
+    if (settings_.number_of_players
+        < settings_.maximum_number_of_participants) {
+      error("The number of players must be at least the maximum number of "
+            "participants per game.");
+    }
+    for (const double probability :
+         {settings_.custom_faction_probability, settings_.teams_probability,
+          settings_.duration_probability}) {
+      if (probability < 0.0 || probability > 1.0) {
+        error("'" + real_number_to_string(probability)
+              + "' is not a valid probability.");
+      }
+    }
+    if (!(settings_.player_skew >= 0.0) || !(settings_.faction_skew >= 0.0)
+        || std::isinf(settings_.player_skew)
+        || std::isinf(settings_.faction_skew)) {
+      error("The player and faction skews must be finite and not negative.");
+    }
+    if (settings_.victory_point_goals.empty()) {
+      error("At least one victory point goal is required.");
+    }
+    for (const int64_t goal : settings_.victory_point_goals) {
+      if (goal <= 0) {
+        error("'" + std::to_string(goal)
+              + "' is not a valid victory point goal.");
+      }
+    }
+    if (settings_.last_date < settings_.first_date) {
+      error("The last date must not be earlier than the first date.");
+    }
+  }
+
+  /// \brief Maximum number of draws from a Zipf-like distribution that are
+  /// attempted in order to draw an index that has not been drawn yet.
+  static constexpr const std::size_t MaximumNumberOfRedraws{64};
+
+  /// \brief Draws an index from a Zipf-like distribution without replacement,
+  /// given the indices that were already drawn.
+  /// \details Redraws until the index is new, which is quick unless the skew
+  /// is so large that the indices already drawn hold almost all of the weight.
+  /// In that case, the index is instead drawn among the remaining ones as the
+  /// one with the smallest key log(E) + skew * log(rank), where E is drawn from
+  /// an exponential distribution. This draws each remaining index with a
+  /// probability proportional to its weight, and the keys are computed in
+  /// logarithmic space such that they do not underflow for any skew.
+  static std::size_t draw_distinct(
+      std::mt19937_64& engine,
+      std::discrete_distribution<std::size_t>& distribution, const double skew,
+      const std::vector<std::size_t>& drawn) noexcept {
+    for (std::size_t attempt = 0; attempt < MaximumNumberOfRedraws;
+         ++attempt) {
+      const std::size_t index{distribution(engine)};
+      if (std::find(drawn.cbegin(), drawn.cend(), index) == drawn.cend()) {
+        return index;
+      }
+    }
+    std::exponential_distribution<double> exponential{1.0};
+    const std::size_t size{distribution.max() + 1};
+    std::size_t best_index{size};
+    double best_key{0.0};
+    for (std::size_t index = 0; index < size; ++index) {
+      if (std::find(drawn.cbegin(), drawn.cend(), index) != drawn.cend()) {
+        continue;
+      }
+      const double key{std::log(exponential(engine))
+                       + skew * std::log(static_cast<double>(index + 1))};
+      if (best_index == size || key < best_key) {
+        best_index = index;
+        best_key = key;
+      }
+    }
+    return best_index;
+  }
+
+  /// \brief Weights of a Zipf-like distribution over a number of ranks.
+  static std::vector<double> zipf_weights(
+      const std::size_t size, const double skew) noexcept {
+    std::vector<double> weights(size);
+    for (std::size_t rank = 0; rank < size; ++rank) {
+      weights[rank] = 1.0 / std::pow(static_cast<double>(rank + 1), skew);
+    }
+    return weights;
+  }
+
+  /// \brief Number of days from 1970-01-01 to a given date in the proleptic
+  /// Gregorian calendar.
+  static int64_t days(const Date& date) noexcept {
+    const int64_t year{date.year() - (date.month_number() <= 2 ? 1 : 0)};
+    const int64_t era{(year >= 0 ? year : year - 399) / 400};
+    const int64_t year_of_era{year - era * 400};
+    const int64_t month{date.month_number()};
+    const int64_t day_of_year{
+        (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5
+        + date.day_number() - 1};
+    const int64_t day_of_era{
+        year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year};
+    return era * 146097 + day_of_era - 719468;
+  }
+
+  /// \brief Date that is a given number of days after 1970-01-01. This is the
+  /// inverse of days().
+  static Date date(int64_t days) noexcept {
+    days += 719468;
+    const int64_t era{(days >= 0 ? days : days - 146096) / 146097};
+    const int64_t day_of_era{days - era * 146097};
+    const int64_t year_of_era{
+        (day_of_era - day_of_era / 1460 + day_of_era / 36524
+         - day_of_era / 146096)
+        / 365};
+    const int64_t day_of_year{
+        day_of_era
+        - (365 * year_of_era + year_of_era / 4 - year_of_era / 100)};
+    const int64_t shifted_month{(5 * day_of_year + 2) / 153};
+    const int64_t day{day_of_year - (153 * shifted_month + 2) / 5 + 1};
+    const int64_t month{shifted_month < 10 ? shifted_month + 3 :
+                                             shifted_month - 9};
+    const int64_t year{year_of_era + era * 400 + (month <= 2 ? 1 : 0)};
+    return {static_cast<int16_t>(year), static_cast<int8_t>(month),
+            static_cast<int8_t>(day)};
+  }
+
+};  // class GamesGenerator
+
+}  // namespace TI4Echelon
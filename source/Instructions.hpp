@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Base.hpp"
+#include "Date.hpp"
+#include "PlotEngine.hpp"
 
 namespace TI4Echelon {
 
@@ -18,6 +20,50 @@ const std::string LeaderboardDirectoryKey{"--leaderboard"};
 const std::string LeaderboardDirectoryPattern{
     LeaderboardDirectoryKey + " <path>"};
 
+const std::string ThreadsKey{"--threads"};
+
+const std::string ThreadsPattern{ThreadsKey + " <number>"};
+
+const std::string JobsKey{"--jobs"};
+
+const std::string JobsPattern{JobsKey + " <number>"};
+
+const std::string PlotsKey{"--plots"};
+
+const std::string PlotsPattern{PlotsKey + " gnuplot|svg"};
+
+const std::string CheckpointFileKey{"--checkpoint"};
+
+const std::string CheckpointFilePattern{CheckpointFileKey + " <path>"};
+
+const std::string StateFileKey{"--state"};
+
+const std::string StateFilePattern{StateFileKey + " <path>"};
+
+const std::string ProfileKey{"--profile"};
+
+const std::string WatchKey{"--watch"};
+
+const std::string ServeKey{"--serve"};
+
+const std::string ServePattern{ServeKey + " <port>"};
+
+const std::string PlayerKey{"--player"};
+
+const std::string PlayerPattern{PlayerKey + " <name>"};
+
+const std::string FactionKey{"--faction"};
+
+const std::string FactionPattern{FactionKey + " <name>"};
+
+const std::string TopKey{"--top"};
+
+const std::string TopPattern{TopKey + " <number>"};
+
+const std::string AsOfKey{"--as-of"};
+
+const std::string AsOfPattern{AsOfKey + " <date>"};
+
 }  // namespace Arguments
 
 /// \brief Parser and organizer of the program's command-line arguments.
@@ -26,6 +72,10 @@ public:
   Instructions(int argc, char* argv[]) noexcept : executable_name_(argv[0]) {
     assign_arguments(argc, argv);
     initialize();
+    // The answer to a query is the only output.
+    if (query()) {
+      console_messages() = false;
+    }
     message_header_information();
     message_command();
     message_start_information();
@@ -40,6 +90,78 @@ public:
     return leaderboard_directory_;
   }
 
+  /// \brief Path to the checkpoint file. Empty if no checkpoint is used.
+  const std::filesystem::path& checkpoint_file() const noexcept {
+    return checkpoint_file_;
+  }
+
+  /// \brief Path to the state file. Empty if no state file is written.
+  const std::filesystem::path& state_file() const noexcept {
+    return state_file_;
+  }
+
+  /// \brief Number of threads used to parse the games file.
+  std::size_t threads() const noexcept {
+    return threads_;
+  }
+
+  /// \brief Maximum number of concurrent Gnuplot processes used to generate
+  /// the plots.
+  std::size_t jobs() const noexcept {
+    return jobs_;
+  }
+
+  /// \brief Engine used to generate the plots.
+  PlotEngine plot_engine() const noexcept {
+    return plot_engine_.value_or(PlotEngine::Gnuplot);
+  }
+
+  /// \brief Whether to profile the phases of the program.
+  bool profile() const noexcept {
+    return profile_;
+  }
+
+  /// \brief Whether to keep running and update the leaderboard whenever the
+  /// games file changes.
+  bool watch() const noexcept {
+    return watch_;
+  }
+
+  /// \brief Port on which to serve queries of the leaderboard state, or no
+  /// value if queries are not served.
+  std::optional<uint16_t> serve_port() const noexcept {
+    return serve_port_;
+  }
+
+  /// \brief Name of the player to query, or no value if no player is queried.
+  const std::optional<std::string>& player() const noexcept {
+    return player_;
+  }
+
+  /// \brief Name of the faction to query, or no value if no faction is
+  /// queried.
+  const std::optional<std::string>& faction() const noexcept {
+    return faction_;
+  }
+
+  /// \brief Number of top players and factions to query, or no value if the
+  /// top players and factions are not queried.
+  std::optional<std::size_t> top() const noexcept {
+    return top_;
+  }
+
+  /// \brief Date as of which to query the statistics, or no value if they are
+  /// queried as of the latest game.
+  std::optional<Date> as_of() const noexcept {
+    return as_of_;
+  }
+
+  /// \brief Whether to answer a query on the console instead of writing the
+  /// leaderboard.
+  bool query() const noexcept {
+    return player_.has_value() || faction_.has_value() || top_.has_value();
+  }
+
 private:
   std::string executable_name_;
 
@@ -49,6 +171,40 @@ private:
 
   std::filesystem::path leaderboard_directory_;
 
+  std::filesystem::path checkpoint_file_;
+
+  std::filesystem::path state_file_;
+
+  /// \brief Defaults to the number of concurrent threads supported by the
+  /// hardware. Zero if the given number of threads is invalid.
+  std::size_t threads_{
+      std::max(std::thread::hardware_concurrency(), static_cast<unsigned>(1))};
+
+  /// \brief Defaults to the number of concurrent threads supported by the
+  /// hardware. Zero if the given number of jobs is invalid.
+  std::size_t jobs_{
+      std::max(std::thread::hardware_concurrency(), static_cast<unsigned>(1))};
+
+  /// \brief Defaults to Gnuplot. No value if the given plot engine is invalid.
+  std::optional<PlotEngine> plot_engine_{PlotEngine::Gnuplot};
+
+  bool profile_{false};
+
+  bool watch_{false};
+
+  /// \brief Zero if the given port is invalid.
+  std::optional<uint16_t> serve_port_;
+
+  std::optional<std::string> player_;
+
+  std::optional<std::string> faction_;
+
+  /// \brief Zero if the given number is invalid.
+  std::optional<std::size_t> top_;
+
+  /// \brief Default-constructed if the given date is invalid.
+  std::optional<Date> as_of_;
+
   void message_header_information() const noexcept {
     message(Program::Title);
     message(Program::Description);
@@ -59,17 +215,43 @@ private:
     const std::string space{"  "};
     message("Usage:");
     message(space + executable_name_ + " " + Arguments::GamesFilePattern + " "
-            + Arguments::LeaderboardDirectoryPattern);
+            + Arguments::LeaderboardDirectoryPattern + " "
+            + Arguments::ThreadsPattern + " " + Arguments::JobsPattern + " "
+            + Arguments::PlotsPattern + " "
+            + Arguments::CheckpointFilePattern + " "
+            + Arguments::StateFilePattern + " [" + Arguments::ProfileKey
+            + "] [" + Arguments::WatchKey + "] " + Arguments::ServePattern
+            + " " + Arguments::PlayerPattern + " " + Arguments::FactionPattern
+            + " " + Arguments::TopPattern + " " + Arguments::AsOfPattern);
     const std::size_t length{std::max(
         {Arguments::UsageInformation.length(),
          Arguments::GamesFilePattern.length(),
-         Arguments::LeaderboardDirectoryPattern.length()})};
+         Arguments::LeaderboardDirectoryPattern.length(),
+         Arguments::ThreadsPattern.length(), Arguments::JobsPattern.length(),
+         Arguments::PlotsPattern.length(),
+         Arguments::CheckpointFilePattern.length(),
+         Arguments::StateFilePattern.length(), Arguments::ProfileKey.length(),
+         Arguments::WatchKey.length(), Arguments::ServePattern.length(),
+         Arguments::PlayerPattern.length(), Arguments::FactionPattern.length(),
+         Arguments::TopPattern.length(), Arguments::AsOfPattern.length()})};
     message("Arguments:");
     message(space + pad_to_length(Arguments::UsageInformation, length) + space
             + "Displays this information and exits.");
     message(space + pad_to_length(Arguments::GamesFilePattern, length) + space
             + "Path to the games file to be read. Required.");
     message(space + pad_to_length(Arguments::LeaderboardDirectoryPattern, length) + space + "Path to the directory in which the leaderboard will be written. Optional. If omitted, no leaderboard is written.");
+    message(space + pad_to_length(Arguments::ThreadsPattern, length) + space + "Number of threads used to parse the games file. Optional. If omitted, the number of concurrent threads supported by the hardware is used.");
+    message(space + pad_to_length(Arguments::JobsPattern, length) + space + "Maximum number of Gnuplot processes run concurrently to generate the plots. Optional. If omitted, the number of concurrent threads supported by the hardware is used.");
+    message(space + pad_to_length(Arguments::PlotsPattern, length) + space + "Engine used to generate the plots: either 'gnuplot', which runs Gnuplot to generate PNG images, or 'svg', which renders SVG images directly without Gnuplot. Optional. If omitted, Gnuplot is used.");
+    message(space + pad_to_length(Arguments::CheckpointFilePattern, length) + space + "Path to a checkpoint file of the player and faction statistics. Optional. If the file exists and was written from the same games, only the games added since then are applied. The file is then updated. If omitted, all games are applied.");
+    message(space + pad_to_length(Arguments::StateFilePattern, length) + space + "Path to a state file in which the player and faction statistics are written such that the ti4-echelon-query tool can map it into memory and answer queries instantly. Optional. The file is updated whenever the statistics change. If omitted, no state file is written.");
+    message(space + pad_to_length(Arguments::ProfileKey, length) + space + "Measures the wall time, CPU time, peak memory usage, and number of heap allocations of each phase of the program and prints a summary. Optional. If a leaderboard is written, the summary is also written to it as JSON.");
+    message(space + pad_to_length(Arguments::WatchKey, length) + space + "Keeps running after the leaderboard is written and watches the games file. Whenever the games file changes, only its new or edited games are read, the statistics are updated from the earliest game that changed, and only the leaderboard files whose content changed are rewritten. Optional. If omitted, the program exits once the leaderboard is written.");
+    message(space + pad_to_length(Arguments::ServePattern, length) + space + "Keeps running after the leaderboard is written and answers HTTP queries of the players, factions, and games with JSON documents on a given port of the local host. Combine with " + Arguments::WatchKey + " to keep the answers up to date as the games file changes. Optional. If omitted, no queries are served.");
+    message(space + pad_to_length(Arguments::PlayerPattern, length) + space + "Prints the rank, statistics, and history of a player as JSON instead of writing the leaderboard. Only the player statistics are computed. Optional.");
+    message(space + pad_to_length(Arguments::FactionPattern, length) + space + "Prints the rank, statistics, and history of a faction as JSON instead of writing the leaderboard. Any spelling of the faction's name is accepted. Only the faction statistics are computed. Optional.");
+    message(space + pad_to_length(Arguments::TopPattern, length) + space + "Prints the statistics of a given number of top players and factions by average rating as JSON instead of writing the leaderboard. Optional.");
+    message(space + pad_to_length(Arguments::AsOfPattern, length) + space + "Date in the YYYY-MM-DD format as of which the statistics of a query are computed. Games played after this date are ignored. Optional. If omitted, all games are used.");
     message("");
   }
 
@@ -97,6 +279,69 @@ private:
       } else if (*argument == Arguments::LeaderboardDirectoryKey
                  && argument + 1 < arguments_.cend()) {
         leaderboard_directory_ = {*(argument + 1)};
+      } else if (*argument == Arguments::CheckpointFileKey
+                 && argument + 1 < arguments_.cend()) {
+        checkpoint_file_ = {*(argument + 1)};
+      } else if (*argument == Arguments::StateFileKey
+                 && argument + 1 < arguments_.cend()) {
+        state_file_ = {*(argument + 1)};
+      } else if (*argument == Arguments::ProfileKey) {
+        profile_ = true;
+      } else if (*argument == Arguments::WatchKey) {
+        watch_ = true;
+      } else if (*argument == Arguments::ServeKey
+                 && argument + 1 < arguments_.cend()) {
+        const std::optional<int64_t> number{
+            string_to_integer_number(*(argument + 1))};
+        if (number.has_value() && number.value() > 0
+            && number.value() <= std::numeric_limits<uint16_t>::max()) {
+          serve_port_ = static_cast<uint16_t>(number.value());
+        } else {
+          serve_port_ = 0;
+        }
+      } else if (*argument == Arguments::PlayerKey
+                 && argument + 1 < arguments_.cend()) {
+        player_ = *(argument + 1);
+      } else if (*argument == Arguments::FactionKey
+                 && argument + 1 < arguments_.cend()) {
+        faction_ = *(argument + 1);
+      } else if (*argument == Arguments::TopKey
+                 && argument + 1 < arguments_.cend()) {
+        const std::optional<int64_t> number{
+            string_to_integer_number(*(argument + 1))};
+        if (number.has_value() && number.value() > 0) {
+          top_ = static_cast<std::size_t>(number.value());
+        } else {
+          top_ = 0;
+        }
+      } else if (*argument == Arguments::AsOfKey
+                 && argument + 1 < arguments_.cend()) {
+        try {
+          as_of_ = Date{*(argument + 1)};
+        } catch (const std::exception&) {
+          as_of_ = Date{};
+        }
+      } else if (*argument == Arguments::PlotsKey
+                 && argument + 1 < arguments_.cend()) {
+        plot_engine_ = type<PlotEngine>(*(argument + 1));
+      } else if (*argument == Arguments::JobsKey
+                 && argument + 1 < arguments_.cend()) {
+        const std::optional<int64_t> number{
+            string_to_integer_number(*(argument + 1))};
+        if (number.has_value() && number.value() > 0) {
+          jobs_ = static_cast<std::size_t>(number.value());
+        } else {
+          jobs_ = 0;
+        }
+      } else if (*argument == Arguments::ThreadsKey
+                 && argument + 1 < arguments_.cend()) {
+        const std::optional<int64_t> number{
+            string_to_integer_number(*(argument + 1))};
+        if (number.has_value() && number.value() > 0) {
+          threads_ = static_cast<std::size_t>(number.value());
+        } else {
+          threads_ = 0;
+        }
       }
     }
   }
@@ -125,6 +370,26 @@ private:
           "The leaderboard directory (" + Arguments::LeaderboardDirectoryPattern
           + ") is missing. Leaderboard files will not be written.");
     }
+    if (!checkpoint_file_.empty()) {
+      message("The checkpoint file is '" + checkpoint_file_.string() + "'.");
+    }
+    if (!state_file_.empty()) {
+      message("The state file will be written to '" + state_file_.string()
+              + "'.");
+    }
+    if (plot_engine_ == PlotEngine::Svg) {
+      message("The plots will be rendered as SVG images.");
+    }
+    if (profile_) {
+      message("The phases of the program will be profiled.");
+    }
+    if (watch_) {
+      message("The games file will be watched for changes.");
+    }
+    if (serve_port_.has_value() && serve_port_.value() > 0) {
+      message("Queries will be served on port "
+              + std::to_string(serve_port_.value()) + ".");
+    }
   }
 
   void check() const {
@@ -132,6 +397,53 @@ private:
       message_usage_information();
       error("The games file (" + Arguments::GamesFilePattern + ") is missing.");
     }
+    if (threads_ == 0) {
+      message_usage_information();
+      error("The number of threads (" + Arguments::ThreadsPattern
+            + ") must be a positive integer.");
+    }
+    if (jobs_ == 0) {
+      message_usage_information();
+      error("The number of jobs (" + Arguments::JobsPattern
+            + ") must be a positive integer.");
+    }
+    if (serve_port_.has_value() && serve_port_.value() == 0) {
+      message_usage_information();
+      error("The port (" + Arguments::ServePattern
+            + ") must be an integer between 1 and 65535.");
+    }
+    if (top_.has_value() && top_.value() == 0) {
+      message_usage_information();
+      error("The number of top players and factions (" + Arguments::TopPattern
+            + ") must be a positive integer.");
+    }
+    if (as_of_.has_value() && as_of_.value() == Date{}) {
+      message_usage_information();
+      error("The date (" + Arguments::AsOfPattern
+            + ") must be a valid date in the YYYY-MM-DD format.");
+    }
+    if (query()
+        && (!leaderboard_directory_.empty() || !state_file_.empty() || watch_
+            || serve_port_.has_value())) {
+      message_usage_information();
+      error("A query (" + Arguments::PlayerPattern + ", "
+            + Arguments::FactionPattern + ", or " + Arguments::TopPattern
+            + ") only prints its answer and cannot be combined with "
+            + Arguments::LeaderboardDirectoryPattern + ", "
+            + Arguments::StateFilePattern + ", " + Arguments::WatchKey
+            + ", or " + Arguments::ServePattern + ".");
+    }
+    if (as_of_.has_value() && !query()) {
+      message_usage_information();
+      error("The date (" + Arguments::AsOfPattern + ") requires a query ("
+            + Arguments::PlayerPattern + ", " + Arguments::FactionPattern
+            + ", or " + Arguments::TopPattern + ").");
+    }
+    if (!plot_engine_.has_value()) {
+      message_usage_information();
+      error("The plot engine (" + Arguments::PlotsPattern
+            + ") must be either 'gnuplot' or 'svg'.");
+    }
   }
 
 };  // class Instructions
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "Date.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Builds a compact JSON document in memory. Commas between the members
+/// of objects and the elements of arrays are inserted automatically.
+class JsonWriter {
+public:
+  JsonWriter() noexcept {}
+
+  const std::string& text() const noexcept {
+    return text_;
+  }
+
+  JsonWriter& begin_object() noexcept {
+    separate();
+    text_ += '{';
+    need_separator_ = false;
+    return *this;
+  }
+
+  JsonWriter& end_object() noexcept {
+    text_ += '}';
+    need_separator_ = true;
+    return *this;
+  }
+
+  JsonWriter& begin_array() noexcept {
+    separate();
+    text_ += '[';
+    need_separator_ = false;
+    return *this;
+  }
+
+  JsonWriter& end_array() noexcept {
+    text_ += ']';
+    need_separator_ = true;
+    return *this;
+  }
+
+  /// \brief Writes the key of the next member of the current object.
+  JsonWriter& key(const std::string_view key_) noexcept {
+    separate();
+    append_string(key_);
+    text_ += ':';
+    need_separator_ = false;
+    return *this;
+  }
+
+  JsonWriter& value(const std::string_view text) noexcept {
+    separate();
+    append_string(text);
+    need_separator_ = true;
+    return *this;
+  }
+
+  JsonWriter& value(const std::string& text) noexcept {
+    return value(std::string_view{text});
+  }
+
+  JsonWriter& value(const char* const text) noexcept {
+    return value(std::string_view{text});
+  }
+
+  JsonWriter& value(const uint64_t number) noexcept {
+    separate();
+    char buffer[24];
+    const std::to_chars_result result{
+        std::to_chars(buffer, buffer + sizeof(buffer), number)};
+    text_.append(buffer, result.ptr);
+    need_separator_ = true;
+    return *this;
+  }
+
+  JsonWriter& value(const int64_t number) noexcept {
+    separate();
+    char buffer[24];
+    const std::to_chars_result result{
+        std::to_chars(buffer, buffer + sizeof(buffer), number)};
+    text_.append(buffer, result.ptr);
+    need_separator_ = true;
+    return *this;
+  }
+
+  /// \brief Writes a date as a string in the YYYY-MM-DD format.
+  JsonWriter& value(const Date& date) noexcept {
+    separate();
+    text_ += '"';
+    date.print(text_);
+    text_ += '"';
+    need_separator_ = true;
+    return *this;
+  }
+
+  /// \brief Writes a real number with a given number of decimals, from 0 to
+  /// 6. The number is rounded to an integer multiple of the last decimal and
+  /// printed as an integer, which is much faster than printing it as a real
+  /// number.
+  JsonWriter& value(const double number, const int8_t decimals) noexcept {
+    separate();
+    constexpr const std::array<int64_t, 7> scales{
+        1, 10, 100, 1000, 10000, 100000, 1000000};
+    const int64_t scale{
+        scales[static_cast<std::size_t>(std::clamp(decimals, int8_t{0},
+                                                   int8_t{6}))]};
+    if (!std::isfinite(number)
+        || std::abs(number) >= 1.0e15 / static_cast<double>(scale)) {
+      text_ += std::isfinite(number) ? real_number_to_string(number, decimals) :
+                                       "null";
+      need_separator_ = true;
+      return *this;
+    }
+    const int64_t scaled{std::llround(number * static_cast<double>(scale))};
+    if (scaled < 0) {
+      text_ += '-';
+    }
+    const uint64_t magnitude{static_cast<uint64_t>(std::abs(scaled))};
+    char buffer[24];
+    text_.append(
+        buffer,
+        std::to_chars(buffer, buffer + sizeof(buffer),
+                      magnitude / static_cast<uint64_t>(scale))
+            .ptr);
+    if (scale > 1) {
+      text_ += '.';
+      const std::to_chars_result fraction{
+          std::to_chars(buffer, buffer + sizeof(buffer),
+                        magnitude % static_cast<uint64_t>(scale)
+                            + static_cast<uint64_t>(scale))};
+      // Skip the leading 1 used to keep the leading zeros of the fraction.
+      text_.append(buffer + 1, fraction.ptr);
+    }
+    need_separator_ = true;
+    return *this;
+  }
+
+  JsonWriter& value(const bool boolean) noexcept {
+    separate();
+    text_ += boolean ? "true" : "false";
+    need_separator_ = true;
+    return *this;
+  }
+
+  JsonWriter& null() noexcept {
+    separate();
+    text_ += "null";
+    need_separator_ = true;
+    return *this;
+  }
+
+private:
+  std::string text_;
+
+  /// \brief Whether a comma must be written before the next value or key.
+  bool need_separator_{false};
+
+  void separate() noexcept {
+    if (need_separator_) {
+      text_ += ',';
+      need_separator_ = false;
+    }
+  }
+
+  /// \brief Writes a string, escaping the characters that cannot appear
+  /// unescaped in a JSON string.
+  void append_string(const std::string_view text) noexcept {
+    text_ += '"';
+    if (std::none_of(text.cbegin(), text.cend(), [](const char character) {
+          return character == '"' || character == '\\'
+                 || static_cast<unsigned char>(character) < 0x20;
+        })) {
+      text_ += text;
+      text_ += '"';
+      return;
+    }
+    for (const char character : text) {
+      switch (character) {
+        case '"':
+          text_ += "\\\"";
+          break;
+        case '\\':
+          text_ += "\\\\";
+          break;
+        case '\n':
+          text_ += "\\n";
+          break;
+        case '\r':
+          text_ += "\\r";
+          break;
+        case '\t':
+          text_ += "\\t";
+          break;
+        default:
+          if (static_cast<unsigned char>(character) < 0x20) {
+            constexpr const char digits[]{"0123456789abcdef"};
+            text_ += "\\u00";
+            text_ += digits[(character >> 4) & 0xf];
+            text_ += digits[character & 0xf];
+          } else {
+            text_ += character;
+          }
+          break;
+      }
+    }
+    text_ += '"';
+  }
+
+};  // class JsonWriter
+
+}  // namespace TI4Echelon
@@ -3,30 +3,49 @@
 #include "DataFileWriter.hpp"
 #include "DurationPlotConfigurationFileWriter.hpp"
 #include "LeaderboardFileWriter.hpp"
+#include "PlotGenerator.hpp"
+#include "Plots.hpp"
 #include "PointsPlotConfigurationFileWriter.hpp"
+#include "ProfileFileWriter.hpp"
 #include "RatingsPlotConfigurationFileWriter.hpp"
+#include "SvgPlotFileWriter.hpp"
 #include "WinRatesPlotConfigurationFileWriter.hpp"
 
 namespace TI4Echelon {
 
 /// \brief Class that writes all leaderboard files given games, players, and
-/// factions data.
+/// factions data. The content hash of each file is recorded in a manifest in
+/// the leaderboard directory, such that the next run only rewrites the files
+/// and regenerates the plots whose content changed.
 class Leaderboard {
 public:
+  /// \brief Writes all leaderboard files. Plots are either generated by up to
+  /// a given number of concurrent Gnuplot processes or rendered directly as SVG
+  /// images.
   Leaderboard(const std::filesystem::path& directory, const Games& games,
-              const Players& players, const Factions& factions) {
+              const Players& players, const Factions& factions,
+              const std::size_t jobs = 1,
+              const PlotEngine plot_engine = PlotEngine::Gnuplot) {
     if (!directory.empty()) {
+      const ProfilerScope profiler_scope{"Write the leaderboard"};
       create_directories(directory, players, factions);
+      OutputManifest::get().open(directory);
       write_player_data_files(directory, players);
       write_faction_data_files(directory, factions);
       write_duration_data_files(directory, games);
-      write_leaderboard_file(directory, games, players, factions);
-      write_player_plot_configuration_files(directory, players);
-      write_faction_plot_configuration_files(directory, factions);
-      write_duration_plot_configuration_file(directory, games);
-      generate_player_plots(directory);
-      generate_faction_plots(directory, factions);
-      generate_duration_plot(directory);
+      write_leaderboard_file(
+          directory, games, players, factions, plot_engine);
+      if (plot_engine == PlotEngine::Svg) {
+        write_player_svg_plot_files(directory, players);
+        write_faction_svg_plot_files(directory, factions);
+        write_duration_svg_plot_file(directory, games);
+      } else {
+        write_player_plot_configuration_files(directory, players);
+        write_faction_plot_configuration_files(directory, factions);
+        write_duration_plot_configuration_file(directory, games);
+        generate_plots(directory, players, factions, jobs);
+      }
+      close_manifest();
       message("Wrote the leaderboard to '" + directory.string() + "'.");
     }
   }
@@ -35,6 +54,7 @@ private:
   void create_directories(
       const std::filesystem::path& directory, const Players& players,
       const Factions& factions) const {
+    const ProfilerScope profiler_scope{"Create the directories"};
     create(directory);
     create(directory / Path::PlayersDirectoryName);
     create(directory / Path::FactionsDirectoryName);
@@ -49,74 +69,76 @@ private:
 
   void write_player_data_files(
       const std::filesystem::path& directory, const Players& players) const {
+    const ProfilerScope profiler_scope{"Write the player data files"};
     for (const Player& player : players) {
-      Table table;
-      table.insert_column("GlobalGameNumber");      // Column index 0
-      table.insert_column("PlayerGameNumber");      // Column index 1
-      table.insert_column("Date");                  // Column index 2
-      table.insert_column("CurrentRating");         // Column index 3
-      table.insert_column("AverageRating");         // Column index 4
-      table.insert_column("AveragePointsPerGame");  // Column index 5
-      table.insert_column("EffectiveWinRate");      // Column index 6
-      table.insert_column("1stPlacePercentage");    // Column index 7
-      table.insert_column("2ndPlacePercentage");    // Column index 8
-      table.insert_column("3rdPlacePercentage");    // Column index 9
-      for (Player::const_reverse_iterator snapshot = player.crbegin();
-           snapshot != player.crend(); ++snapshot) {
-        table.column(0).insert_row(snapshot->global_game_number());
-        table.column(1).insert_row(snapshot->local_game_number());
-        table.column(2).insert_row(snapshot->date());
-        table.column(3).insert_row(snapshot->current_elo_rating());
-        table.column(4).insert_row(snapshot->average_elo_rating());
-        table.column(5).insert_row(snapshot->average_victory_points_per_game());
-        table.column(6).insert_row(snapshot->effective_win_rate());
-        table.column(7).insert_row(snapshot->place_percentage({1}));
-        table.column(8).insert_row(snapshot->place_percentage({2}));
-        table.column(9).insert_row(snapshot->place_percentage({3}));
-      }
       DataFileWriter{directory / Path::PlayersDirectoryName
                          / player.name().path() / Path::PlayerDataFileName,
-                     table};
+                     snapshot_history_table(player.snapshots())};
     }
     message("Wrote the player data files.");
   }
 
   void write_faction_data_files(
       const std::filesystem::path& directory, const Factions& factions) const {
+    const ProfilerScope profiler_scope{"Write the faction data files"};
     for (const Faction& faction : factions) {
-      Table table;
-      table.insert_column("GlobalGameNumber");      // Column index 0
-      table.insert_column("PlayerGameNumber");      // Column index 1
-      table.insert_column("Date");                  // Column index 2
-      table.insert_column("CurrentRating");         // Column index 3
-      table.insert_column("AverageRating");         // Column index 4
-      table.insert_column("AveragePointsPerGame");  // Column index 5
-      table.insert_column("EffectiveWinRate");      // Column index 6
-      table.insert_column("1stPlacePercentage");    // Column index 7
-      table.insert_column("2ndPlacePercentage");    // Column index 8
-      table.insert_column("3rdPlacePercentage");    // Column index 9
-      for (Player::const_reverse_iterator snapshot = faction.crbegin();
-           snapshot != faction.crend(); ++snapshot) {
-        table.column(0).insert_row(snapshot->global_game_number());
-        table.column(1).insert_row(snapshot->local_game_number());
-        table.column(2).insert_row(snapshot->date());
-        table.column(3).insert_row(snapshot->current_elo_rating());
-        table.column(4).insert_row(snapshot->average_elo_rating());
-        table.column(5).insert_row(snapshot->average_victory_points_per_game());
-        table.column(6).insert_row(snapshot->effective_win_rate());
-        table.column(7).insert_row(snapshot->place_percentage({1}));
-        table.column(8).insert_row(snapshot->place_percentage({2}));
-        table.column(9).insert_row(snapshot->place_percentage({3}));
-      }
       DataFileWriter{directory / Path::FactionsDirectoryName
                          / path(faction.name()) / Path::FactionDataFileName,
-                     table};
+                     snapshot_history_table(faction.snapshots())};
     }
     message("Wrote the faction data files.");
   }
 
+  /// \brief Table of a snapshot history in reverse-chronological order. Each
+  /// column is filled by streaming through the corresponding column of the
+  /// snapshot history.
+  Table snapshot_history_table(const SnapshotHistory& history) const noexcept {
+    const std::size_t size{history.size()};
+    Table table;
+    table.insert_column("GlobalGameNumber");      // Column index 0
+    table.insert_column("PlayerGameNumber");      // Column index 1
+    table.insert_column("Date");                  // Column index 2
+    table.insert_column("CurrentRating");         // Column index 3
+    table.insert_column("AverageRating");         // Column index 4
+    table.insert_column("AveragePointsPerGame");  // Column index 5
+    table.insert_column("EffectiveWinRate");      // Column index 6
+    table.insert_column("1stPlacePercentage");    // Column index 7
+    table.insert_column("2ndPlacePercentage");    // Column index 8
+    table.insert_column("3rdPlacePercentage");    // Column index 9
+    for (std::size_t index = size; index-- > 0;) {
+      table.column(0).insert_row(history.global_game_numbers()[index]);
+    }
+    for (std::size_t index = size; index-- > 0;) {
+      table.column(1).insert_row(index + 1);
+    }
+    for (std::size_t index = size; index-- > 0;) {
+      table.column(2).insert_row(history.dates()[index]);
+    }
+    for (std::size_t index = size; index-- > 0;) {
+      table.column(3).insert_row(history.current_elo_ratings()[index]);
+    }
+    for (std::size_t index = size; index-- > 0;) {
+      table.column(4).insert_row(history.average_elo_ratings()[index]);
+    }
+    for (std::size_t index = size; index-- > 0;) {
+      table.column(5).insert_row(
+          history.average_victory_points_per_game()[index]);
+    }
+    for (std::size_t index = size; index-- > 0;) {
+      table.column(6).insert_row(history.effective_win_rates()[index]);
+    }
+    for (int8_t place = 1; place <= 3; ++place) {
+      for (std::size_t index = size; index-- > 0;) {
+        table.column(6 + place).insert_row(
+            history.place_percentage(index, {place}));
+      }
+    }
+    return table;
+  }
+
   void write_duration_data_files(const std::filesystem::path& directory,
                                  const Games& games) const noexcept {
+    const ProfilerScope profiler_scope{"Write the duration data files"};
     write_duration_values_data_files(directory, games);
     write_duration_regression_fit_data_files(directory, games);
   }
@@ -157,13 +179,17 @@ private:
 
   void write_leaderboard_file(
       const std::filesystem::path& directory, const Games& games,
-      const Players& players, const Factions& factions) const {
-    LeaderboardFileWriter{directory, games, players, factions};
+      const Players& players, const Factions& factions,
+      const PlotEngine plot_engine) const {
+    const ProfilerScope profiler_scope{"Write the leaderboard file"};
+    LeaderboardFileWriter{directory, games, players, factions, plot_engine};
     message("Wrote the leaderboard Markdown file.");
   }
 
   void write_player_plot_configuration_files(
       const std::filesystem::path& directory, const Players& players) const {
+    const ProfilerScope profiler_scope{
+        "Write the player plot configuration files"};
     RatingsPlotConfigurationFileWriter{directory, players};
     PointsPlotConfigurationFileWriter{directory, players};
     WinRatesPlotConfigurationFileWriter{directory, players};
@@ -172,6 +198,8 @@ private:
 
   void write_faction_plot_configuration_files(
       const std::filesystem::path& directory, const Factions& factions) const {
+    const ProfilerScope profiler_scope{
+        "Write the faction plot configuration files"};
     RatingsPlotConfigurationFileWriter{directory, factions, Half::First};
     PointsPlotConfigurationFileWriter{directory, factions, Half::First};
     WinRatesPlotConfigurationFileWriter{directory, factions, Half::First};
@@ -184,68 +212,142 @@ private:
   void write_duration_plot_configuration_file(
       const std::filesystem::path& directory,
       const Games& games) const noexcept {
+    const ProfilerScope profiler_scope{
+        "Write the duration plot configuration file"};
     DurationPlotConfigurationFileWriter{directory, games};
     message("Wrote the duration plot configuration Gnuplot file.");
   }
 
-  void generate_player_plots(const std::filesystem::path& directory) const {
-    message("Generating the player plots...");
-    generate_plot(directory / Path::PlayersDirectoryName
-                  / file_name(Path::RatingsPlotFileStem,
-                              Path::PlotConfigurationFileExtension));
-    generate_plot(directory / Path::PlayersDirectoryName
-                  / file_name(Path::PointsPlotFileStem,
-                              Path::PlotConfigurationFileExtension));
-    generate_plot(directory / Path::PlayersDirectoryName
-                  / file_name(Path::WinRatesPlotFileStem,
-                              Path::PlotConfigurationFileExtension));
-    message("Generated the player plots.");
+  void write_player_svg_plot_files(
+      const std::filesystem::path& directory, const Players& players) const {
+    const ProfilerScope profiler_scope{"Write the player SVG plot files"};
+    const std::filesystem::path players_directory{
+        directory / Path::PlayersDirectoryName};
+    SvgPlotFileWriter{
+        players_directory / Path::RatingsPlotFileStem, ratings_plot(players)};
+    SvgPlotFileWriter{
+        players_directory / Path::PointsPlotFileStem, points_plot(players)};
+    SvgPlotFileWriter{players_directory / Path::WinRatesPlotFileStem,
+                      win_rates_plot(players)};
+    message("Wrote the player SVG plot files.");
   }
 
-  void generate_faction_plots(
+  void write_faction_svg_plot_files(
       const std::filesystem::path& directory, const Factions& factions) const {
-    message("Generating the faction plots...");
-    generate_plot(directory / Path::FactionsDirectoryName
-                  / file_name(Path::RatingsPlotFileStem, Half::First,
-                              Path::PlotConfigurationFileExtension));
-    generate_plot(directory / Path::FactionsDirectoryName
-                  / file_name(Path::PointsPlotFileStem, Half::First,
-                              Path::PlotConfigurationFileExtension));
-    generate_plot(directory / Path::FactionsDirectoryName
-                  / file_name(Path::WinRatesPlotFileStem, Half::First,
-                              Path::PlotConfigurationFileExtension));
-    if (factions.need_two_plots()) {
-      generate_plot(directory / Path::FactionsDirectoryName
-                    / file_name(Path::RatingsPlotFileStem, Half::Second,
-                                Path::PlotConfigurationFileExtension));
-      generate_plot(directory / Path::FactionsDirectoryName
-                    / file_name(Path::PointsPlotFileStem, Half::Second,
-                                Path::PlotConfigurationFileExtension));
-      generate_plot(directory / Path::FactionsDirectoryName
-                    / file_name(Path::WinRatesPlotFileStem, Half::Second,
-                                Path::PlotConfigurationFileExtension));
-    }
-    message("Generated the faction plots.");
-  }
-
-  void generate_duration_plot(const std::filesystem::path& directory) const {
-    message("Generating the duration plot...");
-    generate_plot(directory
-                  / file_name(Path::DurationPlotFileStem,
-                              Path::PlotConfigurationFileExtension));
-    message("Generated the duration plot.");
-  }
-
-  /// \brief Generate a plot using Gnuplot. If the path points to a file that
-  /// does not exist, no plot is generated.
-  void generate_plot(const std::filesystem::path& path) const {
-    if (std::filesystem::exists(path)) {
-      const std::string command{"gnuplot " + path.string()};
-      const int outcome{std::system(command.c_str())};
-      if (outcome != 0) {
-        error("Could not run the command: " + command);
+    const ProfilerScope profiler_scope{"Write the faction SVG plot files"};
+    const std::filesystem::path factions_directory{
+        directory / Path::FactionsDirectoryName};
+    for (const Half half : {Half::First, Half::Second}) {
+      if (half == Half::First || factions.need_two_plots()) {
+        const std::string suffix{label(half)};
+        SvgPlotFileWriter{
+            factions_directory / (Path::RatingsPlotFileStem.string() + suffix),
+            ratings_plot(factions, half)};
+        SvgPlotFileWriter{
+            factions_directory / (Path::PointsPlotFileStem.string() + suffix),
+            points_plot(factions, half)};
+        SvgPlotFileWriter{
+            factions_directory / (Path::WinRatesPlotFileStem.string() + suffix),
+            win_rates_plot(factions, half)};
       }
     }
+    message("Wrote the faction SVG plot files.");
+  }
+
+  void write_duration_svg_plot_file(
+      const std::filesystem::path& directory, const Games& games) const {
+    const ProfilerScope profiler_scope{"Write the duration SVG plot file"};
+    SvgPlotFileWriter{
+        directory / Path::DurationPlotFileStem, duration_plot(games)};
+    message("Wrote the duration SVG plot file.");
+  }
+
+  /// \brief Writes the manifest of the leaderboard files and reports how many
+  /// files were left untouched because their content did not change.
+  void close_manifest() const {
+    OutputManifest::get().close();
+    const std::size_t skipped{OutputManifest::get().number_of_skipped_files()};
+    if (skipped > 0) {
+      message("Left " + std::to_string(skipped)
+              + " unchanged files untouched and wrote "
+              + std::to_string(OutputManifest::get().number_of_written_files())
+              + " files.");
+    }
+  }
+
+  /// \brief Generate all plots using a pool of concurrent Gnuplot processes.
+  void generate_plots(const std::filesystem::path& directory,
+                      const Players& players, const Factions& factions,
+                      const std::size_t jobs) const {
+    const ProfilerScope profiler_scope{"Generate the plots"};
+    message("Generating the plots...");
+    PlotGenerator plot_generator{jobs};
+    insert_player_plots(directory, players, plot_generator);
+    insert_faction_plots(directory, factions, plot_generator);
+    insert_duration_plot(directory, plot_generator);
+    plot_generator.generate();
+    message("Generated the plots.");
+    if (plot_generator.number_of_skipped_plots() > 0) {
+      message("Skipped "
+              + std::to_string(plot_generator.number_of_skipped_plots())
+              + " plots whose inputs did not change.");
+    }
+  }
+
+  void insert_player_plots(
+      const std::filesystem::path& directory, const Players& players,
+      PlotGenerator& plot_generator) const {
+    std::vector<std::filesystem::path> inputs;
+    for (const Player& player : players) {
+      if (player.color().has_value()) {
+        inputs.push_back(directory / Path::PlayersDirectoryName
+                         / player.name().path() / Path::PlayerDataFileName);
+      }
+    }
+    for (const std::filesystem::path& stem :
+         {Path::RatingsPlotFileStem, Path::PointsPlotFileStem,
+          Path::WinRatesPlotFileStem}) {
+      plot_generator.insert(
+          directory / Path::PlayersDirectoryName
+              / file_name(stem, Path::PlotConfigurationFileExtension),
+          inputs);
+    }
+  }
+
+  void insert_faction_plots(
+      const std::filesystem::path& directory, const Factions& factions,
+      PlotGenerator& plot_generator) const {
+    for (const Half half : {Half::First, Half::Second}) {
+      if (half == Half::Second && !factions.need_two_plots()) {
+        continue;
+      }
+      std::vector<std::filesystem::path> inputs;
+      for (const Faction& faction : factions) {
+        if (faction.half().has_value() && faction.half().value() == half
+            && faction.color().has_value()) {
+          inputs.push_back(directory / Path::FactionsDirectoryName
+                           / path(faction.name()) / Path::FactionDataFileName);
+        }
+      }
+      for (const std::filesystem::path& stem :
+           {Path::RatingsPlotFileStem, Path::PointsPlotFileStem,
+            Path::WinRatesPlotFileStem}) {
+        plot_generator.insert(
+            directory / Path::FactionsDirectoryName
+                / file_name(stem, half, Path::PlotConfigurationFileExtension),
+            inputs);
+      }
+    }
+  }
+
+  void insert_duration_plot(const std::filesystem::path& directory,
+                            PlotGenerator& plot_generator) const {
+    plot_generator.insert(
+        directory
+            / file_name(Path::DurationPlotFileStem,
+                        Path::PlotConfigurationFileExtension),
+        {directory / Path::DurationValuesDataFileName,
+         directory / Path::DurationRegressionFitDataFileName});
   }
 
 };  // class Leaderboard
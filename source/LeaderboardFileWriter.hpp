@@ -12,8 +12,10 @@ class LeaderboardFileWriter : public MarkdownFileWriter {
 public:
   LeaderboardFileWriter(
       const std::filesystem::path& directory, const Games& games,
-      const Players& players, const Factions& factions) noexcept
-    : MarkdownFileWriter(directory / Path::LeaderboardFileName) {
+      const Players& players, const Factions& factions,
+      const PlotEngine plot_engine = PlotEngine::Gnuplot)
+    : MarkdownFileWriter(directory / Path::LeaderboardFileName),
+      plot_image_file_extension_(plot_image_file_extension(plot_engine)) {
     introduction();
     players_section(players);
     factions_section(factions);
@@ -21,9 +23,12 @@ public:
     games_section(games);
     license_section();
     blank_line();
+    write();
   }
 
 private:
+  std::filesystem::path plot_image_file_extension_;
+
   const std::string section_title_players_{"Players"};
 
   const std::string section_title_factions_{"Factions"};
@@ -115,25 +120,20 @@ private:
          sorted_average_elo_ratings_and_player_names(players)) {
       const Players::const_iterator player{
           players.find(average_elo_rating_and_player_name.second)};
+      const Snapshot& latest_snapshot{*player->latest_snapshot()};
       table_.column(0).insert_row(player->name());
       table_.column(1).insert_row(player->number_of_snapshots());
-      table_.column(2).insert_row(
-          player->latest_snapshot().value().current_elo_rating());
-      table_.column(3).insert_row(
-          player->latest_snapshot().value().average_elo_rating());
+      table_.column(2).insert_row(latest_snapshot.current_elo_rating());
+      table_.column(3).insert_row(latest_snapshot.average_elo_rating());
       table_.column(4).insert_row(
-          player->latest_snapshot().value().average_victory_points_per_game());
-      table_.column(5).insert_row(
-          player->latest_snapshot().value().effective_win_rate());
+          latest_snapshot.average_victory_points_per_game());
+      table_.column(5).insert_row(latest_snapshot.effective_win_rate());
       table_.column(6).insert_row(
-          player->latest_snapshot().value().print_place_percentage_and_count(
-              {1}));
+          latest_snapshot.print_place_percentage_and_count({1}));
       table_.column(7).insert_row(
-          player->latest_snapshot().value().print_place_percentage_and_count(
-              {2}));
+          latest_snapshot.print_place_percentage_and_count({2}));
       table_.column(8).insert_row(
-          player->latest_snapshot().value().print_place_percentage_and_count(
-              {3}));
+          latest_snapshot.print_place_percentage_and_count({3}));
     }
     table(table_);
     blank_line();
@@ -149,10 +149,10 @@ private:
     std::map<EloRating, PlayerName, EloRating::sort>
         sorted_average_elo_ratings_and_player_names_;
     for (const Player& player : players) {
-      const std::optional<Snapshot> latest_snapshot{player.latest_snapshot()};
-      if (latest_snapshot.has_value()) {
+      const Snapshot* const latest_snapshot{player.latest_snapshot()};
+      if (latest_snapshot != nullptr) {
         sorted_average_elo_ratings_and_player_names_.emplace(
-            latest_snapshot.value().average_elo_rating(), player.name());
+            latest_snapshot->average_elo_rating(), player.name());
       }
     }
     return sorted_average_elo_ratings_and_player_names_;
@@ -162,7 +162,7 @@ private:
     line("![Players Ratings Plot]("
          + std::filesystem::path{Path::PlayersDirectoryName
                                  / file_name(Path::RatingsPlotFileStem,
-                                             Path::PlotImageFileExtension)}
+                                             plot_image_file_extension_)}
                .string()
          + ")");
   }
@@ -171,7 +171,7 @@ private:
     line("![Players Points Plot]("
          + std::filesystem::path{Path::PlayersDirectoryName
                                  / file_name(Path::PointsPlotFileStem,
-                                             Path::PlotImageFileExtension)}
+                                             plot_image_file_extension_)}
                .string()
          + ")");
     blank_line();
@@ -184,7 +184,7 @@ private:
     line("![Players Win Rates Plot]("
          + std::filesystem::path{Path::PlayersDirectoryName
                                  / file_name(Path::WinRatesPlotFileStem,
-                                             Path::PlotImageFileExtension)}
+                                             plot_image_file_extension_)}
                .string()
          + ")");
     blank_line();
@@ -233,26 +233,20 @@ private:
       const Factions::const_iterator faction{
           factions.find(average_elo_rating_and_faction_name.second)};
       if (faction->name() != FactionName::Custom) {
+        const Snapshot& latest_snapshot{*faction->latest_snapshot()};
         table_.column(0).insert_row(faction->name());
         table_.column(1).insert_row(faction->number_of_snapshots());
-        table_.column(2).insert_row(
-            faction->latest_snapshot().value().current_elo_rating());
-        table_.column(3).insert_row(
-            faction->latest_snapshot().value().average_elo_rating());
-        table_.column(4).insert_row(faction->latest_snapshot()
-                                        .value()
-                                        .average_victory_points_per_game());
-        table_.column(5).insert_row(
-            faction->latest_snapshot().value().effective_win_rate());
+        table_.column(2).insert_row(latest_snapshot.current_elo_rating());
+        table_.column(3).insert_row(latest_snapshot.average_elo_rating());
+        table_.column(4).insert_row(
+            latest_snapshot.average_victory_points_per_game());
+        table_.column(5).insert_row(latest_snapshot.effective_win_rate());
         table_.column(6).insert_row(
-            faction->latest_snapshot().value().print_place_percentage_and_count(
-                {1}));
+            latest_snapshot.print_place_percentage_and_count({1}));
         table_.column(7).insert_row(
-            faction->latest_snapshot().value().print_place_percentage_and_count(
-                {2}));
+            latest_snapshot.print_place_percentage_and_count({2}));
         table_.column(8).insert_row(
-            faction->latest_snapshot().value().print_place_percentage_and_count(
-                {3}));
+            latest_snapshot.print_place_percentage_and_count({3}));
       }
     }
     table(table_);
@@ -269,10 +263,10 @@ private:
     std::map<EloRating, FactionName, EloRating::sort>
         sorted_average_elo_ratings_and_faction_names_;
     for (const Faction& faction : factions) {
-      const std::optional<Snapshot> latest_snapshot{faction.latest_snapshot()};
-      if (latest_snapshot.has_value()) {
+      const Snapshot* const latest_snapshot{faction.latest_snapshot()};
+      if (latest_snapshot != nullptr) {
         sorted_average_elo_ratings_and_faction_names_.emplace(
-            latest_snapshot.value().average_elo_rating(), faction.name());
+            latest_snapshot->average_elo_rating(), faction.name());
       }
     }
     return sorted_average_elo_ratings_and_faction_names_;
@@ -283,7 +277,7 @@ private:
          + std::filesystem::path{Path::FactionsDirectoryName
                                  / file_name(Path::RatingsPlotFileStem,
                                              Half::First,
-                                             Path::PlotImageFileExtension)}
+                                             plot_image_file_extension_)}
                .string()
          + ")");
     if (factions.need_two_plots()) {
@@ -292,7 +286,7 @@ private:
            + std::filesystem::path{Path::FactionsDirectoryName
                                    / file_name(Path::RatingsPlotFileStem,
                                                Half::Second,
-                                               Path::PlotImageFileExtension)}
+                                               plot_image_file_extension_)}
                  .string()
            + ")");
     }
@@ -303,7 +297,7 @@ private:
          + std::filesystem::path{Path::FactionsDirectoryName
                                  / file_name(Path::PointsPlotFileStem,
                                              Half::First,
-                                             Path::PlotImageFileExtension)}
+                                             plot_image_file_extension_)}
                .string()
          + ")");
     if (factions.need_two_plots()) {
@@ -312,7 +306,7 @@ private:
            + std::filesystem::path{Path::FactionsDirectoryName
                                    / file_name(Path::PointsPlotFileStem,
                                                Half::Second,
-                                               Path::PlotImageFileExtension)}
+                                               plot_image_file_extension_)}
                  .string()
            + ")");
     }
@@ -327,7 +321,7 @@ private:
          + std::filesystem::path{Path::FactionsDirectoryName
                                  / file_name(Path::WinRatesPlotFileStem,
                                              Half::First,
-                                             Path::PlotImageFileExtension)}
+                                             plot_image_file_extension_)}
                .string()
          + ")");
     if (factions.need_two_plots()) {
@@ -336,7 +330,7 @@ private:
            + std::filesystem::path{Path::FactionsDirectoryName
                                    / file_name(Path::WinRatesPlotFileStem,
                                                Half::Second,
-                                               Path::PlotImageFileExtension)}
+                                               plot_image_file_extension_)}
                  .string()
            + ")");
     }
@@ -348,7 +342,7 @@ private:
     section(section_title_duration_);
     line("![Duration Plot]("
          + std::filesystem::path{file_name(Path::DurationPlotFileStem,
-                                           Path::PlotImageFileExtension)}
+                                           plot_image_file_extension_)}
                .string()
          + ")");
     link_back_to_top();
@@ -5,6 +5,8 @@
 namespace TI4Echelon {
 
 /// \brief Linear regression of x-y data.
+/// \details Only the sums of the data are stored, such that a data point can be
+/// inserted in constant time.
 class LinearRegression {
 public:
   /// \brief Default constructor. Initializes to zero slope and zero intercept.
@@ -13,28 +15,8 @@ public:
   /// \brief Construct a linear regression from x-y data.
   LinearRegression(
       const std::vector<std::pair<double, double>>& x_y_data) noexcept {
-    if (x_y_data.empty()) {
-      // Do nothing.
-    } else if (x_y_data.size() == 1) {
-      intercept_ = x_y_data[0].second;
-    } else {
-      // Two or more data points.
-      double n{static_cast<double>(x_y_data.size())};
-      double sum_x{0.0};
-      double sum_y{0.0};
-      double sum_xx{0.0};
-      double sum_xy{0.0};
-      double sum_yy{0.0};
-      for (const std::pair<double, double>& x_y : x_y_data) {
-        sum_x += x_y.first;
-        sum_y += x_y.second;
-        sum_xx += x_y.first * x_y.first;
-        sum_xy += x_y.first * x_y.second;
-        sum_yy += x_y.second * x_y.second;
-      }
-      slope_ =
-          ((n * sum_xy) - (sum_x * sum_y)) / ((n * sum_xx) - sum_x * sum_x);
-      intercept_ = (sum_y - (slope_ * sum_x)) / n;
+    for (const std::pair<double, double>& x_y : x_y_data) {
+      insert(x_y.first, x_y.second);
     }
   }
 
@@ -51,11 +33,39 @@ public:
     return intercept_ + slope_ * x;
   }
 
+  /// \brief Inserts a data point and updates the slope and intercept.
+  void insert(const double x, const double y) noexcept {
+    ++size_;
+    sum_x_ += x;
+    sum_y_ += y;
+    sum_xx_ += x * x;
+    sum_xy_ += x * y;
+    if (size_ == 1) {
+      intercept_ = y;
+    } else {
+      // Two or more data points.
+      const double n{static_cast<double>(size_)};
+      slope_ = ((n * sum_xy_) - (sum_x_ * sum_y_))
+               / ((n * sum_xx_) - sum_x_ * sum_x_);
+      intercept_ = (sum_y_ - (slope_ * sum_x_)) / n;
+    }
+  }
+
 private:
   double slope_{0.0};
 
   double intercept_{0.0};
 
+  std::size_t size_{0};
+
+  double sum_x_{0.0};
+
+  double sum_y_{0.0};
+
+  double sum_xx_{0.0};
+
+  double sum_xy_{0.0};
+
 };  // class LinearRegression
 
 }  // namespace TI4Echelon
@@ -1,13 +1,133 @@
+#include "CheckpointFileWriter.hpp"
+#include "CommandLineQuery.hpp"
+#include "GamesFileWatcher.hpp"
 #include "Instructions.hpp"
 #include "Leaderboard.hpp"
+#include "QueryServer.hpp"
+#include "StateFileWriter.hpp"
 
 int main(int argc, char* argv[]) {
+  TI4Echelon::buffer_console_output();
   const TI4Echelon::Instructions instructions(argc, argv);
-  const TI4Echelon::Games games{instructions.games_file()};
-  const TI4Echelon::Players players{games};
-  const TI4Echelon::Factions factions{games};
+  if (instructions.profile()) {
+    TI4Echelon::Profiler::get().enable();
+  }
+  // Start watching before the games file is first read, such that changes made
+  // while the leaderboard is being written are not missed.
+  std::optional<TI4Echelon::GamesFileWatcher> watcher;
+  if (instructions.watch()) {
+    watcher.emplace(instructions.games_file());
+  }
+  TI4Echelon::Games games{instructions.games_file(), instructions.threads()};
+  if (instructions.query()) {
+    // Compute only the statistics that the query needs, and leave the
+    // checkpoint, state, and leaderboard files untouched.
+    if (instructions.as_of().has_value()) {
+      games.erase_after(instructions.as_of().value());
+    }
+    const TI4Echelon::Checkpoint checkpoint{
+        instructions.checkpoint_file(), games};
+    TI4Echelon::CommandLineQuery query{games, instructions.as_of()};
+    if (instructions.player().has_value() || instructions.top().has_value()) {
+      const TI4Echelon::Players players{games, checkpoint};
+      if (instructions.player().has_value()) {
+        query.player(players, instructions.player().value());
+      }
+      if (instructions.top().has_value()) {
+        query.top("players", players, instructions.top().value());
+      }
+    }
+    if (instructions.faction().has_value() || instructions.top().has_value()) {
+      const TI4Echelon::Factions factions{games, checkpoint};
+      if (instructions.faction().has_value()) {
+        query.faction(factions, instructions.faction().value());
+      }
+      if (instructions.top().has_value()) {
+        query.top("factions", factions, instructions.top().value());
+      }
+    }
+    std::cout << query.text() << std::endl;
+    if (instructions.profile()) {
+      TI4Echelon::console_messages() = true;
+      TI4Echelon::Profiler::get().report();
+    }
+    return EXIT_SUCCESS;
+  }
+  const TI4Echelon::Checkpoint checkpoint{
+      instructions.checkpoint_file(), games};
+  TI4Echelon::Players players{games, checkpoint};
+  TI4Echelon::Factions factions{games, checkpoint};
+  if (!instructions.checkpoint_file().empty() && !checkpoint.covers(games)) {
+    TI4Echelon::CheckpointFileWriter{
+        instructions.checkpoint_file(), games, players, factions};
+  }
+  if (!instructions.state_file().empty()) {
+    TI4Echelon::StateFileWriter{
+        instructions.state_file(), games, players, factions};
+  }
   const TI4Echelon::Leaderboard leaderboard{
-      instructions.leaderboard_directory(), games, players, factions};
+      instructions.leaderboard_directory(), games, players, factions,
+      instructions.jobs(), instructions.plot_engine()};
+  if (instructions.profile()) {
+    TI4Echelon::Profiler::get().report();
+    if (!instructions.leaderboard_directory().empty()) {
+      TI4Echelon::ProfileFileWriter{instructions.leaderboard_directory()
+                                        / TI4Echelon::Path::ProfileFileName,
+                                    TI4Echelon::Profiler::get()};
+    }
+  }
+  std::optional<TI4Echelon::QueryServer> server;
+  if (instructions.serve_port().has_value()) {
+    server.emplace(instructions.serve_port().value(),
+                   std::make_shared<const TI4Echelon::QueryState>(
+                       TI4Echelon::QueryState{games, players, factions}));
+    TI4Echelon::message("Serving queries on http://127.0.0.1:"
+                        + std::to_string(instructions.serve_port().value())
+                        + ".");
+  }
+  while (watcher.has_value()) {
+    TI4Echelon::message("Watching the games file for changes...");
+    std::cout.flush();
+    watcher->wait();
+    try {
+      const std::optional<std::size_t> first_changed_index{
+          games.update(instructions.games_file(), instructions.threads())};
+      if (!first_changed_index.has_value()) {
+        TI4Echelon::message("The games did not change.");
+        continue;
+      }
+      players.correct(games, first_changed_index.value());
+      factions.correct(games, first_changed_index.value());
+      TI4Echelon::message(players.print());
+      TI4Echelon::message(factions.print());
+      if (!instructions.checkpoint_file().empty()) {
+        TI4Echelon::CheckpointFileWriter{
+            instructions.checkpoint_file(), games, players, factions};
+      }
+      if (!instructions.state_file().empty()) {
+        TI4Echelon::StateFileWriter{
+            instructions.state_file(), games, players, factions};
+      }
+      if (server.has_value()) {
+        // The copy shares the players and factions that did not change.
+        // Queries keep reading the previous version until it is published.
+        server->publish(std::make_shared<const TI4Echelon::QueryState>(
+            TI4Echelon::QueryState{games, players, factions}));
+      }
+      const TI4Echelon::Leaderboard updated_leaderboard{
+          instructions.leaderboard_directory(), games, players, factions,
+          instructions.jobs(), instructions.plot_engine()};
+    } catch (const std::exception& exception) {
+      TI4Echelon::warning(
+          std::string{exception.what()}
+          + " The leaderboard is kept as is until the games file changes "
+            "again.");
+    }
+  }
+  if (server.has_value()) {
+    std::cout.flush();
+    server->wait();
+  }
   TI4Echelon::message("End of " + TI4Echelon::Program::Title + ".");
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Base.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Plain text file reader that maps the file into memory and exposes its
+/// lines as string views into the mapping, without copying them.
+/// \details Files that cannot be mapped, such as pipes, are read into a buffer
+/// owned by the reader instead. Either way, the string views remain valid for
+/// the lifetime of the reader.
+class MappedTextFileReader {
+public:
+  MappedTextFileReader(const std::filesystem::path& path) : path_(path) {
+    const int descriptor{::open(path_.c_str(), O_RDONLY)};
+    if (descriptor < 0) {
+      error("Could not open the file: " + path_.string());
+    }
+    struct stat status;
+    if (::fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode)) {
+      size_ = static_cast<std::size_t>(status.st_size);
+      if (size_ > 0) {
+        void* const mapping{
+            ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0)};
+        if (mapping != MAP_FAILED) {
+          data_ = static_cast<const char*>(mapping);
+          ::madvise(mapping, size_, MADV_SEQUENTIAL);
+        }
+      }
+    }
+    if (data_ == nullptr && size_ == 0) {
+      read_into_buffer(descriptor);
+    }
+    ::close(descriptor);
+    if (data_ == nullptr && size_ > 0) {
+      error("Could not map the file: " + path_.string());
+    }
+    initialize_lines();
+  }
+
+  MappedTextFileReader(const MappedTextFileReader&) = delete;
+
+  MappedTextFileReader& operator=(const MappedTextFileReader&) = delete;
+
+  ~MappedTextFileReader() noexcept {
+    if (data_ != nullptr && buffer_.empty()) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  const std::filesystem::path& path() const noexcept {
+    return path_;
+  }
+
+  /// \brief Entire contents of the file.
+  std::string_view contents() const noexcept {
+    return {data_, size_};
+  }
+
+  struct const_iterator : public std::vector<std::string_view>::const_iterator {
+    const_iterator(
+        const std::vector<std::string_view>::const_iterator i) noexcept
+      : std::vector<std::string_view>::const_iterator(i) {}
+  };
+
+  std::size_t size() const noexcept {
+    return lines_.size();
+  }
+
+  const_iterator cbegin() const noexcept {
+    return const_iterator(lines_.cbegin());
+  }
+
+  const_iterator begin() const noexcept {
+    return cbegin();
+  }
+
+  const_iterator cend() const noexcept {
+    return const_iterator(lines_.cend());
+  }
+
+  const_iterator end() const noexcept {
+    return cend();
+  }
+
+private:
+  std::filesystem::path path_;
+
+  /// \brief Start of the contents of the file, either in the memory mapping or
+  /// in the buffer.
+  const char* data_{nullptr};
+
+  std::size_t size_{0};
+
+  /// \brief Contents of the file when it cannot be mapped into memory.
+  std::string buffer_;
+
+  /// \brief Lines of the file, excluding their newline characters.
+  std::vector<std::string_view> lines_;
+
+  void read_into_buffer(const int descriptor) {
+    std::array<char, 65536> chunk;
+    ssize_t count{0};
+    while ((count = ::read(descriptor, chunk.data(), chunk.size())) > 0) {
+      buffer_.append(chunk.data(), static_cast<std::size_t>(count));
+    }
+    if (count < 0) {
+      ::close(descriptor);
+      error("Could not read the file: " + path_.string());
+    }
+    if (!buffer_.empty()) {
+      data_ = buffer_.data();
+      size_ = buffer_.size();
+    }
+  }
+
+  /// \brief Splits the contents into lines in the same way as std::getline: a
+  /// trailing newline does not start an additional empty line.
+  void initialize_lines() noexcept {
+    const std::string_view text{contents()};
+    std::size_t start{0};
+    while (start < text.size()) {
+      std::size_t end{text.find('\n', start)};
+      if (end == std::string_view::npos) {
+        end = text.size();
+      }
+      lines_.push_back(text.substr(start, end - start));
+      start = end + 1;
+    }
+  }
+
+};  // class MappedTextFileReader
+
+}  // namespace TI4Echelon
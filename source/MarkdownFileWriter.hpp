@@ -24,7 +24,10 @@ protected:
   }
 
   void table(const Table& table) noexcept {
-    line(table.print_as_markdown());
+    if (!path_.empty()) {
+      table.print_as_markdown(content_);
+      content_ += '\n';
+    }
   }
 
   void list(const std::string& text) noexcept {
@@ -1,21 +1,52 @@
 #pragma once
 
+#include <unistd.h>
+
 #include "Include.hpp"
 
 namespace TI4Echelon {
 
+/// \brief Size in bytes of the console output buffer when the console output is
+/// redirected to a file or a pipe.
+constexpr const std::size_t ConsoleBufferSize{1 << 16};
+
+/// \brief Fully buffers the console output when it is redirected to a file or a
+/// pipe, such that messages are written in large blocks rather than one line
+/// at a time. Console output to a terminal remains line-buffered. Must be
+/// called before anything is printed.
+inline void buffer_console_output() noexcept {
+  if (::isatty(STDOUT_FILENO) == 0) {
+    std::setvbuf(stdout, nullptr, _IOFBF, ConsoleBufferSize);
+  }
+}
+
+/// \brief Whether general-purpose messages and warnings are printed to the
+/// console. They are disabled when the program prints structured output
+/// instead, such as the answer to a query. Code that builds long messages can
+/// check this first to avoid building them for nothing.
+inline std::atomic<bool>& console_messages() noexcept {
+  static std::atomic<bool> enabled{true};
+  return enabled;
+}
+
 /// \brief Print a general-purpose message to the console.
 inline void message(const std::string& text) noexcept {
-  std::cout << text << std::endl;
+  if (console_messages().load(std::memory_order_relaxed)) {
+    std::cout << text << '\n';
+  }
 }
 
 /// \brief Print a warning to the console.
 inline void warning(const std::string& text) noexcept {
-  std::cout << "Warning: " << text << std::endl;
+  if (console_messages().load(std::memory_order_relaxed)) {
+    std::cout << "Warning: " << text << '\n';
+  }
 }
 
-/// \brief Throw an exception.
+/// \brief Throw an exception. Pending console output is flushed first, such
+/// that it is not lost if the exception terminates the program.
 inline void error(const std::string& text) {
+  std::cout.flush();
   throw std::runtime_error(text);
 }
 
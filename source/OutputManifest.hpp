@@ -0,0 +1,186 @@
+#pragma once
+
+#include "Path.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Manifest of the content hashes of the files written to an output
+/// directory. Used to skip writing files whose content has not changed since
+/// the previous run, such that only the files that actually change are
+/// touched.
+/// \details While the manifest is open, file writers ask it whether a file
+/// whose content hashes to a given value must be written. A file is skipped
+/// only if the previous manifest lists the same hash for it and the file still
+/// exists. When the manifest is closed, the hashes of all files written or
+/// skipped during the run are written to the manifest file. The previous
+/// manifest file is removed as soon as a file is written, such that an
+/// interrupted run never leaves behind a manifest that does not match the
+/// files.
+class OutputManifest {
+public:
+  static OutputManifest& get() noexcept {
+    static OutputManifest manifest;
+    return manifest;
+  }
+
+  OutputManifest(const OutputManifest&) = delete;
+
+  OutputManifest& operator=(const OutputManifest&) = delete;
+
+  /// \brief Starts tracking the files written to a directory, and reads the
+  /// manifest file of the previous run in this directory, if any.
+  void open(const std::filesystem::path& directory) noexcept {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    directory_ = directory;
+    previous_.clear();
+    current_.clear();
+    changed_.clear();
+    number_of_written_files_ = 0;
+    number_of_skipped_files_ = 0;
+    previous_manifest_removed_ = false;
+    const std::filesystem::path path{directory_ / Path::ManifestFileName};
+    std::ifstream stream{path};
+    std::string line;
+    while (std::getline(stream, line)) {
+      // Each line consists of a 16-digit hexadecimal hash, two spaces, and a
+      // path relative to the directory.
+      if (line.size() > 18) {
+        previous_.emplace(
+            line.substr(18),
+            std::strtoull(line.substr(0, 16).c_str(), nullptr, 16));
+      }
+    }
+  }
+
+  /// \brief Writes the manifest file and stops tracking files.
+  void close() {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    if (directory_.empty()) {
+      return;
+    }
+    const std::filesystem::path path{directory_ / Path::ManifestFileName};
+    if (number_of_written_files_ == 0 && current_.size() == previous_.size()
+        && std::filesystem::exists(path)) {
+      // Every file was skipped, so the manifest is unchanged.
+      directory_.clear();
+      return;
+    }
+    std::ofstream stream{path};
+    if (!stream.is_open()) {
+      error("Could not open the file: " + path.string());
+    }
+    for (const std::pair<const std::string, uint64_t>& entry : current_) {
+      stream << hexadecimal(entry.second) << "  " << entry.first << "\n";
+    }
+    directory_.clear();
+  }
+
+  /// \brief Number of files written during the current run.
+  std::size_t number_of_written_files() const noexcept {
+    return number_of_written_files_;
+  }
+
+  /// \brief Number of files skipped during the current run because their
+  /// content did not change.
+  std::size_t number_of_skipped_files() const noexcept {
+    return number_of_skipped_files_;
+  }
+
+  /// \brief Returns whether a file whose content hashes to a given value must
+  /// be written, given whether the file already exists. If the file is skipped,
+  /// its content hash is recorded. Otherwise, it is only recorded by written()
+  /// once the file is successfully written. Files outside the tracked
+  /// directory, or written while no manifest is open, must always be written.
+  bool must_write(const std::filesystem::path& path, const uint64_t hash,
+                  const bool exists) {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    const std::optional<std::string> key{relative(path)};
+    if (!key.has_value()) {
+      return true;
+    }
+    const std::unordered_map<std::string, uint64_t>::const_iterator previous{
+        previous_.find(key.value())};
+    if (exists && previous != previous_.cend() && previous->second == hash) {
+      current_[key.value()] = hash;
+      ++number_of_skipped_files_;
+      return false;
+    }
+    if (!previous_manifest_removed_) {
+      std::error_code error_code;
+      std::filesystem::remove(directory_ / Path::ManifestFileName, error_code);
+      previous_manifest_removed_ = true;
+    }
+    return true;
+  }
+
+  /// \brief Records the content hash of a file that was successfully written.
+  void written(const std::filesystem::path& path, const uint64_t hash) {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    const std::optional<std::string> key{relative(path)};
+    if (key.has_value()) {
+      current_[key.value()] = hash;
+      changed_.insert(key.value());
+      ++number_of_written_files_;
+    }
+  }
+
+  /// \brief Whether a file changed during the current run. Files that are not
+  /// tracked are always considered changed.
+  bool changed(const std::filesystem::path& path) const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    const std::optional<std::string> key{relative(path)};
+    return !key.has_value() || current_.find(key.value()) == current_.cend()
+           || changed_.find(key.value()) != changed_.cend();
+  }
+
+private:
+  OutputManifest() noexcept = default;
+
+  mutable std::mutex mutex_;
+
+  /// \brief Tracked directory. Empty if no manifest is open.
+  std::filesystem::path directory_;
+
+  /// \brief Content hashes of the previous run, by relative path.
+  std::unordered_map<std::string, uint64_t> previous_;
+
+  /// \brief Content hashes of the current run, by relative path. Sorted such
+  /// that the manifest file is written in a stable order.
+  std::map<std::string, uint64_t> current_;
+
+  /// \brief Relative paths of the files written during the current run.
+  std::unordered_set<std::string> changed_;
+
+  std::size_t number_of_written_files_{0};
+
+  std::size_t number_of_skipped_files_{0};
+
+  /// \brief Whether the manifest file of the previous run was removed, which
+  /// is done before the first file is written.
+  bool previous_manifest_removed_{false};
+
+  /// \brief Path relative to the tracked directory, or no value if no manifest
+  /// is open or if the path is outside the tracked directory.
+  std::optional<std::string> relative(
+      const std::filesystem::path& path) const {
+    if (!directory_.empty()) {
+      const std::filesystem::path relative_path{
+          path.lexically_normal().lexically_relative(
+              directory_.lexically_normal())};
+      if (!relative_path.empty() && *relative_path.begin() != "..") {
+        return {relative_path.generic_string()};
+      }
+    }
+    const std::optional<std::string> no_path;
+    return no_path;
+  }
+
+  static std::string hexadecimal(const uint64_t hash) noexcept {
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return stream.str();
+  }
+
+};  // class OutputManifest
+
+}  // namespace TI4Echelon
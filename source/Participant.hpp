@@ -8,7 +8,8 @@
 namespace TI4Echelon {
 
 /// \brief Standing of a participant in a game. Includes a place, a player name,
-/// a number of victory points, and a faction name.
+/// a number of victory points, and a faction name. Stored compactly, since each
+/// game holds its participants inline.
 class Participant {
 public:
   Participant() noexcept {}
@@ -16,8 +17,8 @@ public:
   Participant(const Place& place, const PlayerName& player_name,
               const VictoryPoints& victory_points,
               const FactionName faction_name) noexcept
-    : place_(place), player_name_(player_name), victory_points_(victory_points),
-      faction_name_(faction_name) {}
+    : place_(place), faction_name_(faction_name), player_name_(player_name),
+      victory_points_(static_cast<int32_t>(victory_points.value())) {}
 
   constexpr const Place& place() const noexcept {
     return place_;
@@ -27,8 +28,8 @@ public:
     return player_name_;
   }
 
-  constexpr const VictoryPoints& victory_points() const noexcept {
-    return victory_points_;
+  constexpr VictoryPoints victory_points() const noexcept {
+    return {victory_points_};
   }
 
   constexpr const FactionName faction_name() const noexcept {
@@ -37,7 +38,7 @@ public:
 
   std::string print() const noexcept {
     return place_.print() + " " + player_name_.value() + " "
-           + victory_points_.print() + " " + label(faction_name_);
+           + victory_points().print() + " " + label(faction_name_);
   }
 
   bool operator==(const Participant& other) const noexcept {
@@ -151,11 +152,11 @@ public:
 private:
   Place place_;
 
-  PlayerName player_name_;
+  FactionName faction_name_{FactionName::Custom};
 
-  VictoryPoints victory_points_;
+  PlayerName player_name_;
 
-  FactionName faction_name_{FactionName::Custom};
+  int32_t victory_points_{0};
 
 };  // class Participant
 
@@ -1,10 +1,16 @@
 #pragma once
 
 #include "Participant.hpp"
+#include "StaticVector.hpp"
 
 namespace TI4Echelon {
 
-/// \brief Set of participants in a game.
+/// \brief Maximum number of participants in a game.
+constexpr const std::size_t MaximumNumberOfParticipants{8};
+
+/// \brief Set of participants in a game, sorted from best to worst.
+/// \details The participants are stored inline in a small contiguous array
+/// rather than in a tree, since a game only ever has a handful of them.
 class Participants {
 public:
   /// \brief Default constructor. Initializes an empty set of participants.
@@ -21,21 +27,8 @@ public:
     return text;
   }
 
-  struct const_iterator
-    : public std::set<Participant, Participant::sort>::const_iterator {
-    const_iterator(
-        const std::set<Participant, Participant::sort>::const_iterator
-            i) noexcept
-      : std::set<Participant, Participant::sort>::const_iterator(i) {}
-  };
-
-  struct const_reverse_iterator
-    : public std::set<Participant, Participant::sort>::const_reverse_iterator {
-    const_reverse_iterator(
-        const std::set<Participant, Participant::sort>::const_reverse_iterator
-            i) noexcept
-      : std::set<Participant, Participant::sort>::const_reverse_iterator(i) {}
-  };
+  using const_iterator =
+      StaticVector<Participant, MaximumNumberOfParticipants>::const_iterator;
 
   bool empty() const noexcept {
     return data_.empty();
@@ -53,14 +46,6 @@ public:
     return const_iterator(data_.cbegin());
   }
 
-  const_reverse_iterator rbegin() const noexcept {
-    return const_reverse_iterator(data_.rbegin());
-  }
-
-  const_reverse_iterator crbegin() const noexcept {
-    return const_reverse_iterator(data_.crbegin());
-  }
-
   const_iterator end() const noexcept {
     return const_iterator(data_.end());
   }
@@ -69,28 +54,32 @@ public:
     return const_iterator(data_.cend());
   }
 
-  const_reverse_iterator rend() const noexcept {
-    return const_reverse_iterator(data_.rend());
-  }
-
-  const_reverse_iterator crend() const noexcept {
-    return const_reverse_iterator(data_.crend());
-  }
-
-  std::pair<const_iterator, bool> insert(
-      const Participant& participant) noexcept {
-    return {data_.insert(participant)};
+  /// \brief Inserts a participant in sorted order. Does nothing if an
+  /// identical participant already exists.
+  std::pair<const_iterator, bool> insert(const Participant& participant) {
+    const const_iterator position{std::lower_bound(
+        data_.cbegin(), data_.cend(), participant, Participant::sort())};
+    if (position != data_.cend() && *position == participant) {
+      return {position, false};
+    }
+    const std::size_t index{
+        static_cast<std::size_t>(position - data_.cbegin())};
+    if (data_.size() >= MaximumNumberOfParticipants) {
+      error("A game cannot have more than "
+            + std::to_string(MaximumNumberOfParticipants) + " participants.");
+    }
+    data_.insert(index, participant);
+    return {data_.cbegin() + index, true};
   }
 
   std::pair<const_iterator, bool> emplace(
       const Place& place, const PlayerName& player_name,
-      const VictoryPoints& victory_points,
-      const FactionName faction_name) noexcept {
-    return {data_.emplace(place, player_name, victory_points, faction_name)};
+      const VictoryPoints& victory_points, const FactionName faction_name) {
+    return insert({place, player_name, victory_points, faction_name});
   }
 
 private:
-  std::set<Participant, Participant::sort> data_;
+  StaticVector<Participant, MaximumNumberOfParticipants> data_;
 
 };  // class Participants
 
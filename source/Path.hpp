@@ -1,15 +1,18 @@
 #pragma once
 
 #include "Half.hpp"
+#include "PlotEngine.hpp"
 
 namespace TI4Echelon {
 
 // The directory and file structure is as follows:
 // leaderboard/
 //     README.md
+//     manifest.txt
 //     duration.dat
 //     duration.gnuplot
 //     duration.png
+//     profile.json (only when profiling)
 //     players/
 //         points.gnuplot
 //         points.png
@@ -34,6 +37,9 @@ namespace TI4Echelon {
 //         Argent Flight/
 //             data.dat
 //         etc.
+// The .gnuplot files are only written when the plots are generated by Gnuplot.
+// Otherwise, the plots are rendered directly as .svg images instead of .png
+// images.
 
 namespace Path {
 
@@ -64,6 +70,12 @@ const std::filesystem::path PlotConfigurationFileExtension{"gnuplot"};
 
 const std::filesystem::path PlotImageFileExtension{"png"};
 
+const std::filesystem::path SvgPlotImageFileExtension{"svg"};
+
+const std::filesystem::path ProfileFileName{"profile.json"};
+
+const std::filesystem::path ManifestFileName{"manifest.txt"};
+
 }  // namespace Path
 
 const std::filesystem::path file_name(
@@ -78,4 +90,14 @@ const std::filesystem::path file_name(
   return {stem.string() + label(half) + "." + extension.string()};
 }
 
+/// \brief File extension of the plot images generated by a plot engine.
+const std::filesystem::path& plot_image_file_extension(
+    const PlotEngine plot_engine) noexcept {
+  if (plot_engine == PlotEngine::Svg) {
+    return Path::SvgPlotImageFileExtension;
+  } else {
+    return Path::PlotImageFileExtension;
+  }
+}
+
 }  // namespace TI4Echelon
@@ -21,13 +21,19 @@ public:
   /// \brief Prints to a given number of decimals. For example,
   /// Percentage{0.42}.print() returns "42%".
   std::string print(const int8_t decimals = 0) const noexcept {
+    std::string text;
+    print(text, decimals);
+    return text;
+  }
+
+  /// \brief Appends the percentage to a given number of decimals to an output
+  /// buffer.
+  void print(std::string& output, const int8_t decimals = 0) const noexcept {
     if (value_ == 0.0) {
-      return "0%";
+      output += "0%";
     } else {
-      const double value_100{value_ * 100};
-      std::ostringstream stream;
-      stream << std::fixed << std::setprecision(decimals) << value_100 << "%";
-      return stream.str();
+      append_real_number(output, value_ * 100, decimals);
+      output += '%';
     }
   }
 
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "EloRating.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Number of games between two consecutive recent periodic checkpoints.
+constexpr const std::size_t PeriodicCheckpointInterval{1024};
+
+/// \brief Older periodic checkpoints are thinned out such that the number of
+/// games between two consecutive checkpoints is at most about the number of
+/// games since the newer one divided by this ratio, or the interval if that is
+/// larger. The number of checkpoints thus only grows with the logarithm of the
+/// number of games, and when a past game is corrected, the number of games
+/// applied again before it is at most about this fraction of the number of
+/// games after it, plus the interval.
+constexpr const std::size_t PeriodicCheckpointThinningRatio{4};
+
+/// \brief State of a player or a faction at a periodic checkpoint. Snapshot
+/// histories only ever grow, so a history is restored by truncating it to its
+/// number of snapshots at the time of the checkpoint.
+struct EntityCheckpoint {
+  std::size_t number_of_snapshots{0};
+
+  EloRating lowest_elo_rating;
+
+  EloRating highest_elo_rating;
+};
+
+/// \brief In-memory checkpoints of some state, taken after every
+/// PeriodicCheckpointInterval games, such that the state can be rolled back to
+/// the nearest checkpoint before a corrected game instead of being computed
+/// again from the first game.
+/// \details Recorded states never change, so copies of the checkpoints share
+/// them. A state may only hold what changed since the previous checkpoint: when
+/// a checkpoint is thinned out, the State::merge function of the state combines
+/// its state with that of the next checkpoint, which replaces both.
+template <typename State>
+class PeriodicCheckpoints {
+public:
+  /// \brief Number of games and state of a checkpoint.
+  using Record = std::pair<std::size_t, std::shared_ptr<const State>>;
+
+  PeriodicCheckpoints() noexcept {}
+
+  /// \brief Whether a checkpoint is due after a given number of games, i.e.
+  /// whether the number of games is a positive multiple of the interval and no
+  /// checkpoint was taken yet for this number of games.
+  bool due(const std::size_t number_of_games) const noexcept {
+    return number_of_games > 0
+           && number_of_games % PeriodicCheckpointInterval == 0
+           && (data_.empty() || data_.back().first < number_of_games);
+  }
+
+  /// \brief Records the state after a given number of games. Checkpoints must
+  /// be recorded in chronological order.
+  void record(const std::size_t number_of_games, State&& state) noexcept {
+    data_.emplace_back(
+        number_of_games, std::make_shared<const State>(std::move(state)));
+    thin_out();
+  }
+
+  /// \brief Discards the checkpoints taken after the game with a given index,
+  /// which are no longer valid once that game is corrected. Returns the latest
+  /// remaining checkpoint along with its number of games, or a null pointer if
+  /// there is none, in which case the state must be rolled back to before the
+  /// first game.
+  const Record* rewind(const std::size_t game_index) noexcept {
+    return rewind(game_index, [](const State&) {});
+  }
+
+  /// \brief Same as above, but also calls a function on the state of each
+  /// discarded checkpoint, from the latest to the earliest.
+  template <typename Function>
+  const Record* rewind(
+      const std::size_t game_index, Function&& discarded) noexcept {
+    while (!data_.empty() && data_.back().first > game_index) {
+      discarded(*data_.back().second);
+      data_.pop_back();
+    }
+    if (!data_.empty()) {
+      return &data_.back();
+    } else {
+      return nullptr;
+    }
+  }
+
+  /// \brief Number of games and state of each checkpoint, in chronological
+  /// order.
+  const std::vector<Record>& records() const noexcept {
+    return data_;
+  }
+
+private:
+  /// \brief Number of games and state of each checkpoint, in chronological
+  /// order.
+  std::vector<Record> data_;
+
+  /// \brief Removes each checkpoint whose neighbors are close enough given
+  /// their age, from the latest to the earliest, and merges its state into
+  /// that of the next checkpoint.
+  void thin_out() noexcept {
+    const std::size_t latest{data_.back().first};
+    for (std::size_t index = data_.size() - 1; index >= 2; --index) {
+      const std::size_t gap{data_[index].first - data_[index - 2].first};
+      const std::size_t age{latest - data_[index].first};
+      if (gap <= std::max(PeriodicCheckpointInterval,
+                          age / PeriodicCheckpointThinningRatio)) {
+        data_[index].second = std::make_shared<const State>(
+            State::merge(*data_[index - 1].second, *data_[index].second));
+        data_.erase(data_.begin() + static_cast<std::ptrdiff_t>(index - 1));
+      }
+    }
+  }
+
+};  // class PeriodicCheckpoints
+
+}  // namespace TI4Echelon
@@ -4,6 +4,9 @@
 
 namespace TI4Echelon {
 
+/// \brief Highest possible place in a game. Games have at most 8 places.
+constexpr const int8_t MaximumPlace{8};
+
 /// \brief Finish place within a game, such as 1st, 2nd, 3rd, and so on.
 class Place {
 public:
@@ -15,8 +18,8 @@ public:
   constexpr Place(const int8_t value) noexcept : value_(value) {}
 
   /// \brief Constructor from a string. Expects text such as "1st", "2nd", and
-  /// so on.
-  Place(const std::string& text) noexcept {
+  /// so on, up to the maximum place.
+  Place(const std::string& text) {
     if (text == "1st") {
       value_ = 1;
     } else if (text == "2nd") {
@@ -38,8 +41,8 @@ public:
       const std::optional<int64_t> optional_number{
           string_to_integer_number(digits)};
       if (letters == "th" && optional_number.has_value()
-          && optional_number.value() >= 0
-          && optional_number.value() <= std::numeric_limits<int8_t>::max()) {
+          && optional_number.value() >= 4
+          && optional_number.value() <= MaximumPlace) {
         value_ = static_cast<int8_t>(optional_number.value());
       } else {
         error("'" + text + "' is not a valid place.");
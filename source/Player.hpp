@@ -1,7 +1,8 @@
 #pragma once
 
 #include "Color.hpp"
-#include "Snapshot.hpp"
+#include "PeriodicCheckpoints.hpp"
+#include "SnapshotHistory.hpp"
 
 namespace TI4Echelon {
 
@@ -26,6 +27,10 @@ public:
     return color_;
   }
 
+  void set_color(const std::optional<Color>& color) noexcept {
+    color_ = color;
+  }
+
   const EloRating& lowest_elo_rating() const noexcept {
     return lowest_elo_rating_;
   }
@@ -34,30 +39,59 @@ public:
     return highest_elo_rating_;
   }
 
-  std::optional<Snapshot> latest_snapshot() const {
-    if (!snapshots_.empty()) {
-      return {snapshots_.back()};
-    } else {
-      const std::optional<Snapshot> no_data;
-      return no_data;
-    }
+  /// \brief Latest snapshot of this player, or a null pointer if this player
+  /// does not have any snapshots. The snapshot is not copied.
+  const Snapshot* latest_snapshot() const noexcept {
+    return snapshots_.latest();
+  }
+
+  /// \brief History of this player's snapshots in chronological order.
+  const SnapshotHistory& snapshots() const noexcept {
+    return snapshots_;
+  }
+
+  /// \brief Updates this player with a game in which this player participated
+  /// and this player's updated Elo rating after that game.
+  void update(const Game& game, const EloRating& elo_rating) noexcept {
+    snapshots_.push_back({name_, game, elo_rating, latest_snapshot()});
+    update_lowest_and_highest_elo_ratings();
   }
 
-  void update(
-      const Game& game,
-      const std::unordered_map<PlayerName, EloRating>& elo_ratings) noexcept {
-    if (game.exists(name_)) {
-      snapshots_.emplace_back(name_, game, elo_ratings, latest_snapshot());
-      update_lowest_and_highest_elo_ratings();
+  /// \brief Replaces this player's history of snapshots, such as with one read
+  /// from a checkpoint.
+  void restore(const SnapshotHistory& snapshots) noexcept {
+    snapshots_ = snapshots;
+    lowest_elo_rating_ = {};
+    highest_elo_rating_ = {};
+    for (const EloRating& current_elo_rating :
+         snapshots_.current_elo_ratings()) {
+      if (current_elo_rating < lowest_elo_rating_) {
+        lowest_elo_rating_ = current_elo_rating;
+      }
+      if (current_elo_rating > highest_elo_rating_) {
+        highest_elo_rating_ = current_elo_rating;
+      }
     }
   }
 
+  /// \brief State of this player for a periodic checkpoint.
+  EntityCheckpoint checkpoint() const noexcept {
+    return {snapshots_.size(), lowest_elo_rating_, highest_elo_rating_};
+  }
+
+  /// \brief Rolls this player back to its state at a periodic checkpoint.
+  void roll_back(const EntityCheckpoint& checkpoint) noexcept {
+    snapshots_.truncate(checkpoint.number_of_snapshots);
+    lowest_elo_rating_ = checkpoint.lowest_elo_rating;
+    highest_elo_rating_ = checkpoint.highest_elo_rating;
+  }
+
   /// \brief Prints this player's latest statistics.
   std::string print() const noexcept {
     std::string text{name_.value() + ": "};
-    const std::optional<Snapshot> latest_snapshot_{latest_snapshot()};
-    if (latest_snapshot_.has_value()) {
-      text += latest_snapshot_.value().print();
+    const Snapshot* const latest_snapshot_{latest_snapshot()};
+    if (latest_snapshot_ != nullptr) {
+      text += latest_snapshot_->print();
     } else {
       text += Snapshot{}.print();
     }
@@ -95,54 +129,10 @@ public:
     }
   };
 
-  struct const_iterator : public std::vector<Snapshot>::const_iterator {
-    const_iterator(const std::vector<Snapshot>::const_iterator i) noexcept
-      : std::vector<Snapshot>::const_iterator(i) {}
-  };
-
-  struct const_reverse_iterator
-    : public std::vector<Snapshot>::const_reverse_iterator {
-    const_reverse_iterator(
-        const std::vector<Snapshot>::const_reverse_iterator i) noexcept
-      : std::vector<Snapshot>::const_reverse_iterator(i) {}
-  };
-
   std::size_t number_of_snapshots() const noexcept {
     return snapshots_.size();
   }
 
-  const_iterator begin() const noexcept {
-    return const_iterator(snapshots_.begin());
-  }
-
-  const_iterator cbegin() const noexcept {
-    return const_iterator(snapshots_.cbegin());
-  }
-
-  const_reverse_iterator rbegin() const noexcept {
-    return const_reverse_iterator(snapshots_.rbegin());
-  }
-
-  const_reverse_iterator crbegin() const noexcept {
-    return const_reverse_iterator(snapshots_.crbegin());
-  }
-
-  const_iterator end() const noexcept {
-    return const_iterator(snapshots_.end());
-  }
-
-  const_iterator cend() const noexcept {
-    return const_iterator(snapshots_.cend());
-  }
-
-  const_reverse_iterator rend() const noexcept {
-    return const_reverse_iterator(snapshots_.rend());
-  }
-
-  const_reverse_iterator crend() const noexcept {
-    return const_reverse_iterator(snapshots_.crend());
-  }
-
 private:
   PlayerName name_;
 
@@ -152,15 +142,16 @@ private:
 
   EloRating highest_elo_rating_;
 
-  std::vector<Snapshot> snapshots_;
+  SnapshotHistory snapshots_;
 
   void update_lowest_and_highest_elo_ratings() noexcept {
-    const std::optional<Snapshot> latest_snapshot_{latest_snapshot()};
-    if (latest_snapshot_.value().current_elo_rating() < lowest_elo_rating_) {
-      lowest_elo_rating_ = latest_snapshot_.value().current_elo_rating();
+    const EloRating& current_elo_rating{
+        snapshots_.latest()->current_elo_rating()};
+    if (current_elo_rating < lowest_elo_rating_) {
+      lowest_elo_rating_ = current_elo_rating;
     }
-    if (latest_snapshot_.value().current_elo_rating() > highest_elo_rating_) {
-      highest_elo_rating_ = latest_snapshot_.value().current_elo_rating();
+    if (current_elo_rating > highest_elo_rating_) {
+      highest_elo_rating_ = current_elo_rating;
     }
   }
 
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "EloRating.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Current Elo ratings of all players, stored contiguously and indexed
+/// by player index.
+/// \details Updating the Elo ratings with a game only reads and writes the Elo
+/// ratings of the participants of that game, such that the total cost grows
+/// with the number of participants rather than with the number of players.
+class PlayerEloRatings {
+public:
+  /// \brief Default constructor. Initializes an empty set of Elo ratings.
+  PlayerEloRatings() noexcept {}
+
+  /// \brief Constructs the Elo ratings of a given number of players, each of
+  /// which starts at the default Elo rating.
+  PlayerEloRatings(const std::size_t number_of_players) noexcept
+    : data_(number_of_players) {}
+
+  bool empty() const noexcept {
+    return data_.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return data_.size();
+  }
+
+  const EloRating& operator[](const std::size_t player_index) const noexcept {
+    return data_[player_index];
+  }
+
+  /// \brief Sets the Elo rating of a player, such as one read from a
+  /// checkpoint.
+  void assign(
+      const std::size_t player_index, const EloRating& elo_rating) noexcept {
+    data_[player_index] = elo_rating;
+  }
+
+  /// \brief Appends a player with the default Elo rating, whose player index
+  /// is the previous number of players.
+  void append() noexcept {
+    data_.emplace_back();
+  }
+
+  /// \brief Updates the Elo ratings of the participants of a game. The player
+  /// indices must be listed in the same order as the participants of the game.
+  void update(
+      const Game& game, const std::vector<std::size_t>& player_indices) {
+    if (player_indices.size() != game.participants().size()) {
+      error("The number of player indices does not match the number of "
+            "participants in the game: "
+            + game.print());
+    }
+    // Gather the previous Elo ratings of the participants before any of them
+    // are updated.
+    previous_.clear();
+    std::size_t index{0};
+    for (const Participant& participant : game.participants()) {
+      previous_.emplace_back(participant.place(), data_[player_indices[index]]);
+      ++index;
+    }
+    for (index = 0; index < previous_.size(); ++index) {
+      EloRating elo_rating{previous_[index].second};
+      for (const std::pair<Place, EloRating>& opponent : previous_) {
+        elo_rating.update(
+            previous_[index].first, opponent.first, opponent.second);
+      }
+      data_[player_indices[index]] = elo_rating;
+    }
+  }
+
+private:
+  /// \brief Current Elo rating of each player, indexed by player index.
+  std::vector<EloRating> data_;
+
+  /// \brief Places and previous Elo ratings of the participants of the game
+  /// being processed. Kept as a member to avoid an allocation per game.
+  std::vector<std::pair<Place, EloRating>> previous_;
+
+};  // class PlayerEloRatings
+
+}  // namespace TI4Echelon
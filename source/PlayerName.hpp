@@ -1,58 +1,94 @@
 #pragma once
 
-#include "Base.hpp"
+#include "PlayerNameRegistry.hpp"
 
 namespace TI4Echelon {
 
+/// \brief Name of a player. Player names are interned in the global player
+/// name registry, such that each player name is represented by its player
+/// identifier. Equality comparisons and hashing use the player identifier,
+/// while ordering comparisons remain alphabetical.
 class PlayerName {
 public:
   PlayerName() noexcept {}
 
   PlayerName(const std::string& value) noexcept
-    : value_(remove_non_alphabetic_characters(value)) {}
+    : identifier_(PlayerNameRegistry::get().intern(
+        remove_non_alphabetic_characters(value))) {}
+
+  /// \brief Player name with a given identifier, which must have been assigned
+  /// by the global player name registry.
+  static PlayerName from_identifier(const PlayerId identifier) noexcept {
+    PlayerName player_name;
+    player_name.identifier_ = identifier;
+    return player_name;
+  }
+
+  /// \brief Player name with a given value, or no value if no player with this
+  /// name has been seen before. Unlike the constructor, never registers a new
+  /// player name.
+  static std::optional<PlayerName> find(const std::string& value) noexcept {
+    const std::optional<PlayerId> identifier{PlayerNameRegistry::get().find(
+        remove_non_alphabetic_characters(value))};
+    if (identifier.has_value()) {
+      return {from_identifier(identifier.value())};
+    } else {
+      const std::optional<PlayerName> no_player_name;
+      return no_player_name;
+    }
+  }
+
+  /// \brief Dense identifier of this player name.
+  PlayerId identifier() const noexcept {
+    return identifier_;
+  }
 
   const std::string& value() const noexcept {
-    return value_;
+    return PlayerNameRegistry::get().value(identifier_);
   }
 
   std::filesystem::path path() const noexcept {
-    return {remove_non_alphanumeric_characters(value_)};
+    return {remove_non_alphanumeric_characters(value())};
   }
 
   bool operator==(const PlayerName& other) const noexcept {
-    return value_ == other.value_;
+    return identifier_ == other.identifier_;
   }
 
   bool operator!=(const PlayerName& other) const noexcept {
-    return value_ != other.value_;
+    return identifier_ != other.identifier_;
   }
 
   bool operator<(const PlayerName& other) const noexcept {
-    return value_ < other.value_;
+    return compare(other) < 0;
   }
 
   bool operator<=(const PlayerName& other) const noexcept {
-    return value_ <= other.value_;
+    return compare(other) <= 0;
   }
 
   bool operator>(const PlayerName& other) const noexcept {
-    return value_ > other.value_;
+    return compare(other) > 0;
   }
 
   bool operator>=(const PlayerName& other) const noexcept {
-    return value_ >= other.value_;
+    return compare(other) >= 0;
   }
 
   /// \brief Sort alphabetically.
   struct sort {
     bool operator()(const PlayerName& player_name_1,
                     const PlayerName& player_name_2) const noexcept {
-      return player_name_1.value() < player_name_2.value();
+      return player_name_1 < player_name_2;
     }
   };
 
 private:
-  std::string value_;
+  PlayerId identifier_{0};
+
+  int compare(const PlayerName& other) const noexcept {
+    return PlayerNameRegistry::get().compare(identifier_, other.identifier_);
+  }
 
 };  // class PlayerName
 
@@ -63,7 +99,7 @@ namespace std {
 template <>
 struct hash<TI4Echelon::PlayerName> {
   size_t operator()(const TI4Echelon::PlayerName& player_name) const {
-    return hash<string>()(player_name.value());
+    return hash<TI4Echelon::PlayerId>()(player_name.identifier());
   }
 };
 
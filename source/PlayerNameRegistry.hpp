@@ -0,0 +1,184 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Dense identifier of a distinct player name. Identifiers are assigned
+/// consecutively from zero in the order in which player names are first seen.
+using PlayerId = uint32_t;
+
+/// \brief Global registry of distinct player names. Each distinct player name
+/// is stored once and is assigned a player identifier.
+/// \details The registry is shared by all threads, such that the games file can
+/// be parsed in parallel. Registering and finding a player name take a lock,
+/// but reading and comparing the player names of identifiers do not. Stored
+/// player names never move, so references to them remain valid for the
+/// lifetime of the program, and they can be read while other player names are
+/// registered. Once the games are parsed, each player name is given its
+/// alphabetical rank, such that comparing two player names only compares two
+/// integers.
+class PlayerNameRegistry {
+public:
+  /// \brief The global registry. The empty player name always has identifier
+  /// zero.
+  static PlayerNameRegistry& get() noexcept {
+    static PlayerNameRegistry registry;
+    return registry;
+  }
+
+  PlayerNameRegistry(const PlayerNameRegistry&) = delete;
+
+  PlayerNameRegistry& operator=(const PlayerNameRegistry&) = delete;
+
+  ~PlayerNameRegistry() noexcept {
+    for (const std::atomic<std::string*>& block : blocks_) {
+      delete[] block.load(std::memory_order_relaxed);
+    }
+  }
+
+  /// \brief Number of distinct player names, including the empty player name.
+  std::size_t size() const noexcept {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  /// \brief Returns the identifier of a player name, registering the player
+  /// name if it has not been seen before.
+  PlayerId intern(const std::string& value) noexcept {
+    {
+      const std::shared_lock<std::shared_mutex> lock{mutex_};
+      const std::unordered_map<std::string_view, PlayerId>::const_iterator
+          found{identifiers_.find(value)};
+      if (found != identifiers_.cend()) {
+        return found->second;
+      }
+    }
+    const std::unique_lock<std::shared_mutex> lock{mutex_};
+    // Another thread may have registered the same player name in the meantime.
+    const std::unordered_map<std::string_view, PlayerId>::const_iterator found{
+        identifiers_.find(value)};
+    if (found != identifiers_.cend()) {
+      return found->second;
+    }
+    const PlayerId identifier{static_cast<PlayerId>(size())};
+    const std::pair<std::size_t, std::size_t> location_{location(identifier)};
+    if (location_.second == 0) {
+      blocks_[location_.first].store(
+          new std::string[FirstBlockSize << location_.first],
+          std::memory_order_release);
+    }
+    std::string& stored{
+        blocks_[location_.first].load(std::memory_order_relaxed)
+            [location_.second]};
+    stored = value;
+    identifiers_.emplace(stored, identifier);
+    size_.store(identifier + 1, std::memory_order_release);
+    return identifier;
+  }
+
+  /// \brief Identifier of a player name, or no value if the player name has
+  /// not been seen before. Never registers the player name.
+  std::optional<PlayerId> find(const std::string& value) const noexcept {
+    const std::shared_lock<std::shared_mutex> lock{mutex_};
+    const std::unordered_map<std::string_view, PlayerId>::const_iterator found{
+        identifiers_.find(value)};
+    if (found != identifiers_.cend()) {
+      return {found->second};
+    } else {
+      const std::optional<PlayerId> no_identifier;
+      return no_identifier;
+    }
+  }
+
+  /// \brief Player name corresponding to a player identifier. Does not take
+  /// the lock.
+  const std::string& value(const PlayerId identifier) const noexcept {
+    const std::pair<std::size_t, std::size_t> location_{location(identifier)};
+    return blocks_[location_.first].load(
+        std::memory_order_acquire)[location_.second];
+  }
+
+  /// \brief Compares the player names corresponding to two player identifiers
+  /// alphabetically. Returns a negative number, zero, or a positive number if
+  /// the first player name is before, equal to, or after the second one. Does
+  /// not take the lock. Player names that have an alphabetical rank are
+  /// compared by rank, and the others by their characters.
+  int compare(const PlayerId identifier_1,
+              const PlayerId identifier_2) const noexcept {
+    if (identifier_1 == identifier_2) {
+      return 0;
+    }
+    if (identifier_1 < ranks_.size() && identifier_2 < ranks_.size()) {
+      return ranks_[identifier_1] < ranks_[identifier_2] ? -1 : 1;
+    }
+    return value(identifier_1).compare(value(identifier_2));
+  }
+
+  /// \brief Gives each player name registered so far its alphabetical rank.
+  /// Must not be called while other threads compare player names, such as
+  /// while the games file is parsed.
+  void rank() noexcept {
+    const std::unique_lock<std::shared_mutex> lock{mutex_};
+    if (ranks_.size() == size()) {
+      return;
+    }
+    std::vector<PlayerId> identifiers(size());
+    std::iota(identifiers.begin(), identifiers.end(), PlayerId{0});
+    std::sort(identifiers.begin(), identifiers.end(),
+              [this](const PlayerId identifier_1,
+                     const PlayerId identifier_2) {
+                return value(identifier_1) < value(identifier_2);
+              });
+    ranks_.resize(identifiers.size());
+    for (std::size_t rank_ = 0; rank_ < identifiers.size(); ++rank_) {
+      ranks_[identifiers[rank_]] = static_cast<PlayerId>(rank_);
+    }
+  }
+
+private:
+  /// \brief Number of player names in the first block of player names. Each
+  /// following block holds twice as many player names as the previous one.
+  static constexpr const std::size_t FirstBlockSize{64};
+
+  PlayerNameRegistry() noexcept {
+    intern(std::string{});
+  }
+
+  /// \brief Block and position within the block of the player name with a
+  /// given identifier. Block b holds the identifiers from FirstBlockSize *
+  /// (2^b - 1) onwards.
+  static std::pair<std::size_t, std::size_t> location(
+      const PlayerId identifier) noexcept {
+    const std::size_t position{identifier / FirstBlockSize + 1};
+    std::size_t block{0};
+    while ((position >> (block + 1)) != 0) {
+      ++block;
+    }
+    return {block,
+            identifier - FirstBlockSize * ((std::size_t{1} << block) - 1)};
+  }
+
+  /// \brief Guards the registration of player names and the identifiers of
+  /// player names.
+  mutable std::shared_mutex mutex_;
+
+  /// \brief Blocks of player names, indexed by player identifier as given by
+  /// location(). Blocks are allocated as needed and never move, such that the
+  /// player names can be read without the lock while others are registered.
+  std::array<std::atomic<std::string*>, 32> blocks_{};
+
+  /// \brief Number of registered player names.
+  std::atomic<std::size_t> size_{0};
+
+  /// \brief Alphabetical rank of each player name, indexed by player
+  /// identifier. The player names registered since the last call to rank() do
+  /// not have one yet.
+  std::vector<PlayerId> ranks_;
+
+  /// \brief Player identifier of each player name. The keys are views into the
+  /// stored player names.
+  std::unordered_map<std::string_view, PlayerId> identifiers_;
+
+};  // class PlayerNameRegistry
+
+}  // namespace TI4Echelon
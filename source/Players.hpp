@@ -1,19 +1,90 @@
 #pragma once
 
+#include "Checkpoint.hpp"
+#include "CopyOnWrite.hpp"
 #include "Games.hpp"
 #include "Player.hpp"
+#include "PlayerEloRatings.hpp"
 
 namespace TI4Echelon {
 
-/// \brief A set of players.
+/// \brief A set of players, listed in alphabetical order of their names.
+/// \details Each player is shared between copies of the players until one of
+/// the copies modifies it, so a copy is cheap and only the players who take
+/// part in later games are cloned. Players who first play in a game applied
+/// with apply() are appended after the others, and are only sorted by name
+/// when the players are next corrected.
 class Players {
 public:
-  /// \brief Constructs all player data given the games.
-  Players(const Games& games) noexcept {
+  /// \brief Constructs all player data given the games. If a checkpoint of the
+  /// oldest games is given, the players' statistics are restored from it and
+  /// only the newer games are applied.
+  Players(const Games& games,
+          const Checkpoint& checkpoint = Checkpoint{}) noexcept {
+    const ProfilerScope profiler_scope{"Calculate the player statistics"};
     initialize_data(games);
     initialize_indices();
+    elo_ratings_ = PlayerEloRatings{data_.size()};
+    restore(checkpoint);
     update(games);
-    message(print());
+    if (console_messages()) {
+      message(print());
+    }
+  }
+
+  /// \brief Number of games applied to the players so far.
+  std::size_t number_of_games() const noexcept {
+    return number_of_games_;
+  }
+
+  /// \brief Applies a game played after all of the games applied so far, such
+  /// as a game just appended to the games. Only the participants of the game
+  /// are updated, so the cost grows with the number of participants rather
+  /// than with the number of players. A participant who has not played any
+  /// game yet is first appended to the players, without a plot color.
+  void apply(const Game& game) {
+    if (game.index() != number_of_games_) {
+      error("The game '" + game.print()
+            + "' cannot be applied to the players because it is not the next "
+              "game in chronological order.");
+    }
+    if (periodic_checkpoints_.due(number_of_games_)) {
+      record_periodic_checkpoint();
+    }
+    for (const Participant& participant : game.participants()) {
+      if (!exists(participant.player_name())) {
+        append(participant.player_name());
+      }
+    }
+    participant_indices_.clear();
+    for (const Participant& participant : game.participants()) {
+      participant_indices_.push_back(
+          indices_[participant.player_name().identifier()]);
+    }
+    elo_ratings_.update(game, participant_indices_);
+    for (const std::size_t index : participant_indices_) {
+      Player& player{data_[index].write()};
+      player.update(game, elo_ratings_[index]);
+      update_lowest_and_highest_elo_ratings(player);
+      players_since_periodic_checkpoint_.push_back(player.name().identifier());
+    }
+    ++number_of_games_;
+  }
+
+  /// \brief Corrects the players after past games were edited, inserted, or
+  /// removed, given the index of the earliest game that changed. The players
+  /// are rolled back to the latest periodic checkpoint taken before that game,
+  /// and only the games from that checkpoint onwards are applied again. If
+  /// games were only appended, they are simply applied. Players who no longer
+  /// participate in any game are removed, the players are sorted by name
+  /// again, and the plot colors are assigned again.
+  void correct(const Games& games, const std::size_t first_changed_index) {
+    if (first_changed_index < number_of_games_) {
+      roll_back(first_changed_index);
+    }
+    update(games);
+    sort_players_with_games();
+    initialize_colors(games);
   }
 
   const EloRating& lowest_elo_rating() const noexcept {
@@ -27,15 +98,26 @@ public:
   std::string print() const noexcept {
     std::stringstream stream;
     stream << "Calculated statistics for " << data_.size() << " players:";
-    for (const Player& player : data_) {
-      stream << std::endl << "- " << player.print() << ".";
+    for (const CopyOnWrite<Player>& player : data_) {
+      stream << '\n' << "- " << player->print() << ".";
     }
     return stream.str();
   }
 
-  struct const_iterator : public std::vector<Player>::const_iterator {
-    const_iterator(const std::vector<Player>::const_iterator i) noexcept
-      : std::vector<Player>::const_iterator(i) {}
+  struct const_iterator
+    : public std::vector<CopyOnWrite<Player>>::const_iterator {
+    const_iterator(
+        const std::vector<CopyOnWrite<Player>>::const_iterator i) noexcept
+      : std::vector<CopyOnWrite<Player>>::const_iterator(i) {}
+
+    const Player& operator*() const noexcept {
+      return *std::vector<CopyOnWrite<Player>>::const_iterator::operator*();
+    }
+
+    const Player* operator->() const noexcept {
+      return std::vector<CopyOnWrite<Player>>::const_iterator::operator*()
+          .operator->();
+    }
   };
 
   bool empty() const noexcept {
@@ -63,14 +145,13 @@ public:
   }
 
   bool exists(const PlayerName& name) const noexcept {
-    return indices_.find(name) != indices_.cend();
+    return index(name).has_value();
   }
 
   const_iterator find(const PlayerName& name) const noexcept {
-    const std::unordered_map<PlayerName, std::size_t>::const_iterator found{
-        indices_.find(name)};
-    if (found != indices_.cend()) {
-      return data_.cbegin() + found->second;
+    const std::optional<std::size_t> found{index(name)};
+    if (found.has_value()) {
+      return data_.cbegin() + found.value();
     } else {
       return data_.cend();
     }
@@ -81,70 +162,174 @@ private:
 
   EloRating highest_elo_rating_;
 
-  std::vector<Player> data_;
+  std::vector<CopyOnWrite<Player>> data_;
+
+  /// \brief Index of each player in the data, indexed by player identifier up
+  /// to the largest identifier of the players. Player identifiers that do not
+  /// correspond to any player map to NoIndex.
+  std::vector<std::size_t> indices_;
 
-  std::unordered_map<PlayerName, std::size_t> indices_;
+  static constexpr const std::size_t NoIndex{
+      std::numeric_limits<std::size_t>::max()};
+
+  /// \brief Current Elo rating of each player, indexed by player index.
+  PlayerEloRatings elo_ratings_;
+
+  std::size_t number_of_games_{0};
+
+  /// \brief Indices of the participants of the game being applied. Kept as a
+  /// member to avoid an allocation per game.
+  std::vector<std::size_t> participant_indices_;
+
+  /// \brief State of the players at a periodic checkpoint.
+  struct PeriodicCheckpoint {
+    EloRating lowest_elo_rating;
+
+    EloRating highest_elo_rating;
+
+    /// \brief State of each player who took part in a game since the previous
+    /// checkpoint, sorted by player identifier. The state of any other player
+    /// is that of the previous checkpoint.
+    std::vector<std::pair<PlayerId, EntityCheckpoint>> players;
+
+    /// \brief State of a player at this checkpoint, or a null pointer if the
+    /// player did not take part in a game since the previous checkpoint.
+    const EntityCheckpoint* find(const PlayerId identifier) const noexcept {
+      const std::vector<std::pair<PlayerId, EntityCheckpoint>>::const_iterator
+          found{std::lower_bound(
+              players.cbegin(), players.cend(), identifier,
+              [](const std::pair<PlayerId, EntityCheckpoint>& player,
+                 const PlayerId identifier) {
+                return player.first < identifier;
+              })};
+      if (found != players.cend() && found->first == identifier) {
+        return &found->second;
+      } else {
+        return nullptr;
+      }
+    }
+
+    /// \brief Checkpoint that replaces a checkpoint and the previous one,
+    /// given the previous one first.
+    static PeriodicCheckpoint merge(
+        const PeriodicCheckpoint& previous,
+        const PeriodicCheckpoint& checkpoint) noexcept {
+      PeriodicCheckpoint merged{
+          checkpoint.lowest_elo_rating, checkpoint.highest_elo_rating, {}};
+      merged.players.reserve(
+          previous.players.size() + checkpoint.players.size());
+      // For players in both checkpoints, the union keeps the later state.
+      std::set_union(checkpoint.players.cbegin(), checkpoint.players.cend(),
+                     previous.players.cbegin(), previous.players.cend(),
+                     std::back_inserter(merged.players),
+                     [](const std::pair<PlayerId, EntityCheckpoint>& left,
+                        const std::pair<PlayerId, EntityCheckpoint>& right) {
+                       return left.first < right.first;
+                     });
+      return merged;
+    }
+  };
+
+  PeriodicCheckpoints<PeriodicCheckpoint> periodic_checkpoints_;
+
+  /// \brief Identifiers of the participants of the games applied since the
+  /// latest periodic checkpoint, possibly repeated, along with the players
+  /// restored from a checkpoint file.
+  std::vector<PlayerId> players_since_periodic_checkpoint_;
+
+  std::optional<std::size_t> index(const PlayerName& name) const noexcept {
+    if (name.identifier() < indices_.size()
+        && indices_[name.identifier()] != NoIndex) {
+      return {indices_[name.identifier()]};
+    } else {
+      const std::optional<std::size_t> no_index;
+      return no_index;
+    }
+  }
 
   /// \brief Initialize the players with their names and colors.
   /// \details Only a limited number of players with the most games played are
   /// assigned a color.
   void initialize_data(const Games& games) noexcept {
-    const std::multimap<std::size_t, PlayerName, std::greater<std::size_t>>
-        player_names_by_number_of_games_(
-            player_names_by_number_of_games(games));
-    std::set<PlayerName, PlayerName::sort> player_names_with_colors;
-    std::set<PlayerName, PlayerName::sort> player_names_without_colors;
-    // Assign a color to a number of players with the most games played, and at
-    // least 2 games played.
-    for (const std::pair<const std::size_t, PlayerName>&
+    for (const std::pair<std::size_t, PlayerName>&
              number_of_games_and_player_name :
-         player_names_by_number_of_games_) {
+         player_names_by_number_of_games(games)) {
+      data_.emplace_back(Player{number_of_games_and_player_name.second});
+    }
+    std::sort(data_.begin(), data_.end(),
+              [](const CopyOnWrite<Player>& player_1,
+                 const CopyOnWrite<Player>& player_2) {
+                return *player_1 < *player_2;
+              });
+    initialize_colors(games);
+  }
+
+  /// \brief Assigns a color to a number of players with the most games played,
+  /// and at least 2 games played. The colors are assigned in alphabetical
+  /// order of the players' names. Only the players whose color changes are
+  /// modified.
+  void initialize_colors(const Games& games) noexcept {
+    std::unordered_set<PlayerName> player_names_with_colors;
+    for (const std::pair<std::size_t, PlayerName>&
+             number_of_games_and_player_name :
+         player_names_by_number_of_games(games)) {
       if (player_names_with_colors.size()
-              < maximum_number_of_players_with_colors()
-          && number_of_games_and_player_name.first >= 2) {
-        player_names_with_colors.insert(number_of_games_and_player_name.second);
-      } else {
-        player_names_without_colors.insert(
-            number_of_games_and_player_name.second);
+              >= maximum_number_of_players_with_colors()
+          || number_of_games_and_player_name.first < 2) {
+        break;
       }
+      player_names_with_colors.insert(number_of_games_and_player_name.second);
     }
-    for (const PlayerName& player_name : player_names_with_colors) {
-      const std::size_t color_index{data_.size()};
-      data_.emplace_back(player_name, plot_data_color(color_index));
-    }
-    for (const PlayerName& player_name : player_names_without_colors) {
-      data_.emplace_back(player_name);
+    std::size_t color_index{0};
+    for (CopyOnWrite<Player>& player : data_) {
+      std::optional<Color> color;
+      if (player_names_with_colors.find(player->name())
+          != player_names_with_colors.cend()) {
+        color = plot_data_color(color_index);
+        ++color_index;
+      }
+      if (player->color() != color) {
+        player.write().set_color(color);
+      }
     }
-    std::sort(data_.begin(), data_.end(), Player::sort());
   }
 
-  std::multimap<std::size_t, PlayerName, std::greater<std::size_t>>
+  /// \brief Player names sorted by number of games played in descending order.
+  /// Ties are broken alphabetically.
+  std::vector<std::pair<std::size_t, PlayerName>>
   player_names_by_number_of_games(const Games& games) const noexcept {
-    const std::unordered_map<PlayerName, std::size_t> number_of_games_(
-        number_of_games(games));
-    std::multimap<std::size_t, PlayerName, std::greater<std::size_t>>
+    const std::vector<std::size_t> number_of_games_(number_of_games(games));
+    std::vector<std::pair<std::size_t, PlayerName>>
         player_names_by_number_of_games_;
-    for (const std::pair<const PlayerName, std::size_t>&
-             player_name_and_number_of_games : number_of_games_) {
-      player_names_by_number_of_games_.emplace(
-          player_name_and_number_of_games.second,
-          player_name_and_number_of_games.first);
+    for (PlayerId identifier = 0; identifier < number_of_games_.size();
+         ++identifier) {
+      if (number_of_games_[identifier] > 0) {
+        player_names_by_number_of_games_.emplace_back(
+            number_of_games_[identifier],
+            PlayerName::from_identifier(identifier));
+      }
     }
+    std::sort(player_names_by_number_of_games_.begin(),
+              player_names_by_number_of_games_.end(),
+              [](const std::pair<std::size_t, PlayerName>& pair_1,
+                 const std::pair<std::size_t, PlayerName>& pair_2) {
+                if (pair_1.first != pair_2.first) {
+                  return pair_1.first > pair_2.first;
+                } else {
+                  return pair_1.second < pair_2.second;
+                }
+              });
     return player_names_by_number_of_games_;
   }
 
-  std::unordered_map<PlayerName, std::size_t> number_of_games(
-      const Games& games) const noexcept {
-    std::unordered_map<PlayerName, std::size_t> number_of_games_;
+  /// \brief Number of games played by each player, indexed by player
+  /// identifier.
+  std::vector<std::size_t> number_of_games(const Games& games) const noexcept {
+    std::vector<std::size_t> number_of_games_(
+        PlayerNameRegistry::get().size(), 0);
     for (const Game& game : games) {
       for (const Participant& participant : game.participants()) {
-        const std::unordered_map<PlayerName, std::size_t>::iterator found{
-            number_of_games_.find(participant.player_name())};
-        if (found != number_of_games_.cend()) {
-          ++(found->second);
-        } else {
-          number_of_games_.emplace(participant.player_name(), 1);
-        }
+        ++number_of_games_[participant.player_name().identifier()];
       }
     }
     return number_of_games_;
@@ -156,45 +341,178 @@ private:
   }
 
   void initialize_indices() noexcept {
+    indices_.clear();
     for (std::size_t index = 0; index < data_.size(); ++index) {
-      indices_.emplace(data_[index].name(), index);
+      set_index(data_[index]->name(), index);
     }
   }
 
-  /// \brief Update all the players with all the games.
+  /// \brief Sets the index of a player, growing the indices only up to the
+  /// player's identifier.
+  void set_index(const PlayerName& name, const std::size_t index) noexcept {
+    if (name.identifier() >= indices_.size()) {
+      indices_.resize(name.identifier() + 1, NoIndex);
+    }
+    indices_[name.identifier()] = index;
+  }
+
+  /// \brief Appends a player who has not played any game yet after the other
+  /// players, with the default Elo rating.
+  void append(const PlayerName& name) noexcept {
+    set_index(name, data_.size());
+    data_.emplace_back(Player{name});
+    elo_ratings_.append();
+  }
+
+  /// \brief Removes the players who do not participate in any game, such as
+  /// after the only games of a player were corrected, and sorts the other
+  /// players by name, such as after players were appended.
+  void sort_players_with_games() noexcept {
+    std::vector<std::size_t> kept_indices;
+    kept_indices.reserve(data_.size());
+    for (std::size_t index = 0; index < data_.size(); ++index) {
+      if (data_[index]->snapshots().empty()) {
+        indices_[data_[index]->name().identifier()] = NoIndex;
+      } else {
+        kept_indices.push_back(index);
+      }
+    }
+    std::sort(kept_indices.begin(), kept_indices.end(),
+              [this](const std::size_t index_1, const std::size_t index_2) {
+                return *data_[index_1] < *data_[index_2];
+              });
+    std::vector<CopyOnWrite<Player>> data;
+    data.reserve(kept_indices.size());
+    PlayerEloRatings elo_ratings{kept_indices.size()};
+    for (const std::size_t index : kept_indices) {
+      indices_[data_[index]->name().identifier()] = data.size();
+      elo_ratings.assign(data.size(), elo_ratings_[index]);
+      data.push_back(std::move(data_[index]));
+    }
+    data_ = std::move(data);
+    elo_ratings_ = std::move(elo_ratings);
+  }
+
+  /// \brief Records the state of the players who took part in a game since
+  /// the previous periodic checkpoint.
+  void record_periodic_checkpoint() noexcept {
+    std::sort(players_since_periodic_checkpoint_.begin(),
+              players_since_periodic_checkpoint_.end());
+    players_since_periodic_checkpoint_.erase(
+        std::unique(players_since_periodic_checkpoint_.begin(),
+                    players_since_periodic_checkpoint_.end()),
+        players_since_periodic_checkpoint_.end());
+    PeriodicCheckpoint checkpoint{lowest_elo_rating_, highest_elo_rating_, {}};
+    checkpoint.players.reserve(players_since_periodic_checkpoint_.size());
+    for (const PlayerId identifier : players_since_periodic_checkpoint_) {
+      checkpoint.players.emplace_back(
+          identifier, data_[indices_[identifier]]->checkpoint());
+    }
+    players_since_periodic_checkpoint_.clear();
+    periodic_checkpoints_.record(number_of_games_, std::move(checkpoint));
+  }
+
+  /// \brief Rolls the players back to the latest periodic checkpoint taken no
+  /// later than the game with a given index, or to before the first game if
+  /// there is no such checkpoint. The current Elo rating of each player is
+  /// that of the player's latest remaining snapshot. Only the players who
+  /// took part in games since the checkpoint are modified.
+  void roll_back(const std::size_t game_index) noexcept {
+    std::vector<PlayerId> identifiers{
+        std::move(players_since_periodic_checkpoint_)};
+    players_since_periodic_checkpoint_.clear();
+    const PeriodicCheckpoints<PeriodicCheckpoint>::Record* const checkpoint{
+        periodic_checkpoints_.rewind(
+            game_index, [&identifiers](const PeriodicCheckpoint& discarded) {
+              for (const std::pair<PlayerId, EntityCheckpoint>& player :
+                   discarded.players) {
+                identifiers.push_back(player.first);
+              }
+            })};
+    lowest_elo_rating_ = {};
+    highest_elo_rating_ = {};
+    number_of_games_ = 0;
+    if (checkpoint != nullptr) {
+      lowest_elo_rating_ = checkpoint->second->lowest_elo_rating;
+      highest_elo_rating_ = checkpoint->second->highest_elo_rating;
+      number_of_games_ = checkpoint->first;
+    }
+    std::sort(identifiers.begin(), identifiers.end());
+    identifiers.erase(std::unique(identifiers.begin(), identifiers.end()),
+                      identifiers.end());
+    for (const PlayerId identifier : identifiers) {
+      if (identifier >= indices_.size() || indices_[identifier] == NoIndex) {
+        continue;
+      }
+      const std::size_t index{indices_[identifier]};
+      const EntityCheckpoint player_checkpoint{
+          periodic_checkpoint(identifier)};
+      if (data_[index]->number_of_snapshots()
+          != player_checkpoint.number_of_snapshots) {
+        data_[index].write().roll_back(player_checkpoint);
+      }
+      const Snapshot* const latest_snapshot{data_[index]->latest_snapshot()};
+      elo_ratings_.assign(
+          index, latest_snapshot != nullptr
+                     ? latest_snapshot->current_elo_rating()
+                     : EloRating{});
+    }
+  }
+
+  /// \brief State of a player at the latest remaining periodic checkpoint,
+  /// which is the state recorded by the latest checkpoint at which the player
+  /// had taken part in a game since the previous one.
+  EntityCheckpoint periodic_checkpoint(
+      const PlayerId identifier) const noexcept {
+    const std::vector<PeriodicCheckpoints<PeriodicCheckpoint>::Record>&
+        records{periodic_checkpoints_.records()};
+    for (std::vector<PeriodicCheckpoints<PeriodicCheckpoint>::Record>::
+             const_reverse_iterator record{records.crbegin()};
+         record != records.crend(); ++record) {
+      const EntityCheckpoint* const player{record->second->find(identifier)};
+      if (player != nullptr) {
+        return *player;
+      }
+    }
+    return {};
+  }
+
+  /// \brief Restores the statistics and current Elo ratings of the players
+  /// from a checkpoint, along with the number of games applied to them.
+  void restore(const Checkpoint& checkpoint) noexcept {
+    for (std::size_t index = 0; index < data_.size(); ++index) {
+      Player& player{data_[index].write()};
+      const Checkpoint::Entry* const entry{checkpoint.player(player.name())};
+      if (entry != nullptr) {
+        player.restore(entry->snapshots);
+        elo_ratings_.assign(index, entry->current_elo_rating);
+        update_lowest_and_highest_elo_ratings(player);
+        players_since_periodic_checkpoint_.push_back(
+            player.name().identifier());
+      }
+    }
+    number_of_games_ = checkpoint.number_of_games();
+  }
+
+  /// \brief Update the players with all the games that were not applied yet.
   void update(const Games& games) noexcept {
     // Iterate through the games in chronological order.
     // The games are listed in reverse-chronological order, so use a reverse
     // iterator.
-    for (Games::const_reverse_iterator game = games.crbegin();
+    for (Games::const_reverse_iterator game{
+             games.crbegin() + static_cast<std::ptrdiff_t>(number_of_games_)};
          game != games.crend(); ++game) {
-      const std::unordered_map<PlayerName, EloRating> current_elo_ratings_{
-          current_elo_ratings()};
-      for (Player& player : data_) {
-        player.update(*game, current_elo_ratings_);
-        if (player.lowest_elo_rating() < lowest_elo_rating_) {
-          lowest_elo_rating_ = player.lowest_elo_rating();
-        }
-        if (player.highest_elo_rating() > highest_elo_rating_) {
-          highest_elo_rating_ = player.highest_elo_rating();
-        }
-      }
+      apply(*game);
     }
   }
 
-  std::unordered_map<PlayerName, EloRating>
-  current_elo_ratings() const noexcept {
-    std::unordered_map<PlayerName, EloRating> elo_ratings_;
-    for (const Player& player : data_) {
-      const std::optional<Snapshot> latest_snapshot{player.latest_snapshot()};
-      if (latest_snapshot.has_value()) {
-        elo_ratings_.emplace(
-            player.name(), latest_snapshot.value().current_elo_rating());
-      } else {
-        elo_ratings_.emplace(player.name(), EloRating{});
-      }
+  void update_lowest_and_highest_elo_ratings(const Player& player) noexcept {
+    if (player.lowest_elo_rating() < lowest_elo_rating_) {
+      lowest_elo_rating_ = player.lowest_elo_rating();
+    }
+    if (player.highest_elo_rating() > highest_elo_rating_) {
+      highest_elo_rating_ = player.highest_elo_rating();
     }
-    return elo_ratings_;
   }
 
 };  // class Players
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Color.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Smallest multiple of an increment that is strictly greater than a
+/// value if the value is a whole number, or greater than or equal to the value
+/// otherwise.
+int64_t nearest_higher_nice_number(
+    const double value, const int64_t increment) noexcept {
+  if (std::ceil(value) == value) {
+    return increment * (static_cast<int64_t>(std::ceil(value / increment)) + 1);
+  } else {
+    return increment * static_cast<int64_t>(std::ceil(value / increment));
+  }
+}
+
+/// \brief Largest multiple of an increment that is strictly less than a value
+/// if the value is a whole number, or less than or equal to the value
+/// otherwise.
+int64_t nearest_lower_nice_number(
+    const double value, const int64_t increment) noexcept {
+  if (std::floor(value) == value) {
+    return increment
+           * (static_cast<int64_t>(std::floor(value / increment)) - 1);
+  } else {
+    return increment * static_cast<int64_t>(std::floor(value / increment));
+  }
+}
+
+/// \brief Spacing between the major tics of an axis spanning a given range.
+/// The spacing is 1, 2, or 5 times a power of 10 such that there are at most 8
+/// major intervals.
+double nice_increment(const double range) noexcept {
+  const double rough_increment{range / 8.0};
+  const double magnitude{
+      std::pow(10.0, std::floor(std::log10(rough_increment)))};
+  double increment{magnitude};
+  for (const double factor : {1.0, 2.0, 5.0, 10.0}) {
+    increment = factor * magnitude;
+    if (increment >= rough_increment) {
+      break;
+    }
+  }
+  return increment;
+}
+
+/// \brief Axis of a plot.
+struct PlotAxis {
+  std::string label;
+
+  double minimum{0.0};
+
+  double maximum{1.0};
+
+  /// \brief Spacing between consecutive major tics.
+  double increment{1.0};
+
+  /// \brief Number of minor intervals between consecutive major tics.
+  int64_t minor_intervals{1};
+};
+
+/// \brief Series of data points in a plot, drawn either as a line through the
+/// points or as separate markers.
+struct PlotSeries {
+  /// \brief Title shown in the key of the plot. Series without a title are not
+  /// shown in the key.
+  std::string title;
+
+  Color color{Color::Black};
+
+  bool markers{false};
+
+  std::vector<std::pair<double, double>> points;
+};
+
+/// \brief In-memory description of a plot, independent of how it is rendered.
+struct Plot {
+  PlotAxis x_axis;
+
+  PlotAxis y_axis;
+
+  std::vector<PlotSeries> series;
+
+  /// \brief Sets the range of the horizontal axis such that it spans the data
+  /// points of every series, with major tics at round numbers.
+  void autoscale_x_axis() noexcept {
+    double minimum{std::numeric_limits<double>::max()};
+    double maximum{std::numeric_limits<double>::lowest()};
+    for (const PlotSeries& one_series : series) {
+      for (const std::pair<double, double>& point : one_series.points) {
+        minimum = std::min(minimum, point.first);
+        maximum = std::max(maximum, point.first);
+      }
+    }
+    if (minimum > maximum) {
+      minimum = 0.0;
+      maximum = 1.0;
+    } else if (minimum == maximum) {
+      minimum -= 1.0;
+      maximum += 1.0;
+    }
+    const double increment{nice_increment(maximum - minimum)};
+    x_axis.increment = increment;
+    x_axis.minimum = increment * std::floor(minimum / increment);
+    x_axis.maximum = increment * std::ceil(maximum / increment);
+  }
+};
+
+}  // namespace TI4Echelon
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Path.hpp"
+#include "Plot.hpp"
 #include "TextFileWriter.hpp"
 
 namespace TI4Echelon {
@@ -8,11 +9,6 @@ namespace TI4Echelon {
 /// \brief General-purpose plot configuration file writer for Gnuplot
 /// (.gnuplot).
 class PlotConfigurationFileWriter : public TextFileWriter {
-public:
-  ~PlotConfigurationFileWriter() noexcept {
-    blank_line();
-  }
-
 protected:
   /// \brief Constructor. Takes a file stem, i.e. a file path without a file
   /// extension. The file extension is appended automatically.
@@ -25,24 +21,10 @@ protected:
          + file_name(stem, Path::PlotImageFileExtension).string() + "\"");
   }
 
-  int64_t nearest_higher_nice_number(
-      const double value, const int64_t increment) const noexcept {
-    if (std::ceil(value) == value) {
-      return increment
-             * (static_cast<int64_t>(std::ceil(value / increment)) + 1);
-    } else {
-      return increment * static_cast<int64_t>(std::ceil(value / increment));
-    }
-  }
-
-  int64_t nearest_lower_nice_number(
-      const double value, const int64_t increment) const noexcept {
-    if (std::floor(value) == value) {
-      return increment
-             * (static_cast<int64_t>(std::floor(value / increment)) - 1);
-    } else {
-      return increment * static_cast<int64_t>(std::floor(value / increment));
-    }
+  /// \brief Ends the plot configuration with a blank line and writes it.
+  void write() {
+    blank_line();
+    TextFileWriter::write();
   }
 
 };  // class PlotConfigurationFileWriter
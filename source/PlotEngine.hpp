@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Engine used to generate the plots. Gnuplot generates PNG images by
+/// running a Gnuplot process on each plot configuration file, whereas SVG
+/// renders SVG images directly in the program.
+enum class PlotEngine : int8_t {
+  Gnuplot,
+  Svg,
+};
+
+template <>
+const std::unordered_map<PlotEngine, std::string> labels<PlotEngine>{
+    {PlotEngine::Gnuplot, "gnuplot"},
+    {PlotEngine::Svg,     "svg"    },
+};
+
+template <>
+const std::unordered_map<std::string, PlotEngine> spellings<PlotEngine>{
+    {"gnuplot", PlotEngine::Gnuplot},
+    {"svg",     PlotEngine::Svg    },
+};
+
+}  // namespace TI4Echelon
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include "OutputManifest.hpp"
+
+extern char** environ;
+
+namespace TI4Echelon {
+
+/// \brief Generates plots by running Gnuplot on plot configuration files, using
+/// a bounded pool of concurrent Gnuplot processes.
+/// \details Plots are queued and then generated together. At most a given
+/// number of Gnuplot processes run at any time. The exit status of every
+/// process is collected, and all failures are reported together once every
+/// process has finished. A plot is skipped if its image exists and neither its
+/// plot configuration file nor any of its data files changed during the
+/// current run, as reported by the output manifest.
+class PlotGenerator {
+public:
+  PlotGenerator(const std::size_t jobs) noexcept
+    : jobs_(std::max(jobs, static_cast<std::size_t>(1))) {}
+
+  /// \brief Number of plots skipped because their inputs did not change.
+  std::size_t number_of_skipped_plots() const noexcept {
+    return number_of_skipped_plots_;
+  }
+
+  /// \brief Queues a plot given its plot configuration file and the data files
+  /// that it reads. If the plot configuration file does not exist, no plot is
+  /// generated.
+  void insert(const std::filesystem::path& path,
+              const std::vector<std::filesystem::path>& inputs) {
+    if (!std::filesystem::exists(path)) {
+      return;
+    }
+    if (unchanged(path, inputs)) {
+      ++number_of_skipped_plots_;
+    } else {
+      queue_.push_back(path);
+    }
+  }
+
+  /// \brief Generates all queued plots and waits for them to finish.
+  void generate() {
+    // Flush pending console output such that it precedes any output of the
+    // Gnuplot processes.
+    std::cout.flush();
+    std::map<pid_t, std::filesystem::path> running;
+    std::vector<std::string> failures;
+    std::size_t next{0};
+    while (next < queue_.size() || !running.empty()) {
+      while (next < queue_.size() && running.size() < jobs_) {
+        const std::optional<pid_t> process{spawn(queue_[next])};
+        if (process.has_value()) {
+          running.emplace(process.value(), queue_[next]);
+        } else {
+          failures.push_back(command(queue_[next]) + " (could not start)");
+        }
+        ++next;
+      }
+      if (!running.empty()) {
+        wait(running, failures);
+      }
+    }
+    queue_.clear();
+    if (!failures.empty()) {
+      std::string text;
+      for (const std::string& failure : failures) {
+        text += (text.empty() ? "" : ", ") + failure;
+      }
+      error("Could not run the commands: " + text);
+    }
+  }
+
+private:
+  std::size_t jobs_;
+
+  std::vector<std::filesystem::path> queue_;
+
+  std::size_t number_of_skipped_plots_{0};
+
+  /// \brief Whether the image of a plot exists and neither its plot
+  /// configuration file nor any of its data files changed.
+  static bool unchanged(const std::filesystem::path& path,
+                        const std::vector<std::filesystem::path>& inputs) {
+    const OutputManifest& manifest{OutputManifest::get()};
+    const std::filesystem::path image{
+        std::filesystem::path{path}.replace_extension(
+            Path::PlotImageFileExtension)};
+    if (manifest.changed(path) || !std::filesystem::exists(image)) {
+      return false;
+    }
+    for (const std::filesystem::path& input : inputs) {
+      if (manifest.changed(input)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static std::string command(const std::filesystem::path& path) noexcept {
+    return "gnuplot " + path.string();
+  }
+
+  /// \brief Starts a Gnuplot process on a plot configuration file. Returns its
+  /// process identifier, or no value if it could not be started.
+  static std::optional<pid_t> spawn(
+      const std::filesystem::path& path) noexcept {
+    std::string program{"gnuplot"};
+    std::string argument{path.string()};
+    char* const arguments[]{program.data(), argument.data(), nullptr};
+    pid_t process;
+    if (::posix_spawnp(
+            &process, program.c_str(), nullptr, nullptr, arguments, environ)
+        == 0) {
+      return {process};
+    } else {
+      const std::optional<pid_t> no_process;
+      return no_process;
+    }
+  }
+
+  /// \brief Waits for one of the running Gnuplot processes to finish, and
+  /// records it as a failure if it did not succeed or if its result could not
+  /// be collected. Only these processes are waited for, such that the results
+  /// of other child processes of the program are left for their owners.
+  static void wait(std::map<pid_t, std::filesystem::path>& running,
+                   std::vector<std::string>& failures) noexcept {
+    // Wait for any child process to finish without collecting its result. If
+    // it is not one of the running processes, or if this fails, wait for the
+    // oldest running process instead.
+    siginfo_t information{};
+    const int waited{::waitid(P_ALL, 0, &information, WEXITED | WNOWAIT)};
+    if (waited < 0 && errno == EINTR) {
+      return;
+    }
+    std::map<pid_t, std::filesystem::path>::iterator finished{
+        waited == 0 ? running.find(information.si_pid) : running.end()};
+    if (finished == running.end()) {
+      finished = running.begin();
+    }
+    int status{0};
+    const pid_t process{::waitpid(finished->first, &status, 0)};
+    if (process == finished->first) {
+      if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        failures.push_back(
+            command(finished->second) + " (" + outcome(status) + ")");
+      }
+      running.erase(finished);
+    } else if (errno != EINTR) {
+      failures.push_back(command(finished->second)
+                         + " (its result could not be collected: "
+                         + std::strerror(errno) + ")");
+      running.erase(finished);
+    }
+  }
+
+  static std::string outcome(const int status) noexcept {
+    if (WIFEXITED(status)) {
+      return "exit status " + std::to_string(WEXITSTATUS(status));
+    } else if (WIFSIGNALED(status)) {
+      return "terminated by signal " + std::to_string(WTERMSIG(status));
+    } else {
+      return "unknown status " + std::to_string(status);
+    }
+  }
+
+};  // class PlotGenerator
+
+}  // namespace TI4Echelon
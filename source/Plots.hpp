@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Factions.hpp"
+#include "Games.hpp"
+#include "Plot.hpp"
+#include "Players.hpp"
+
+namespace TI4Echelon {
+
+namespace {
+
+/// \brief Series of a quantity of a snapshot history versus the global game
+/// number, in chronological order.
+PlotSeries snapshot_history_series(
+    const std::string& title, const Color color,
+    const SnapshotHistory& history,
+    const std::function<double(const SnapshotHistory&, const std::size_t)>&
+        quantity) noexcept {
+  PlotSeries series{title, color, false, {}};
+  series.points.reserve(history.size());
+  for (std::size_t index = 0; index < history.size(); ++index) {
+    series.points.emplace_back(
+        static_cast<double>(history.global_game_numbers()[index]),
+        quantity(history, index));
+  }
+  return series;
+}
+
+/// \brief Plot of a quantity of the snapshot histories of the players that
+/// have a plot color.
+Plot snapshot_histories_plot(
+    const Players& players, const PlotAxis& y_axis,
+    const std::function<double(const SnapshotHistory&, const std::size_t)>&
+        quantity) noexcept {
+  Plot plot{{"Game Number"}, y_axis, {}};
+  for (const Player& player : players) {
+    if (player.color().has_value()) {
+      plot.series.push_back(snapshot_history_series(
+          player.name().value(), player.color().value(), player.snapshots(),
+          quantity));
+    }
+  }
+  plot.autoscale_x_axis();
+  return plot;
+}
+
+/// \brief Plot of a quantity of the snapshot histories of the factions in a
+/// given half that have a plot color.
+Plot snapshot_histories_plot(
+    const Factions& factions, const Half half, const PlotAxis& y_axis,
+    const std::function<double(const SnapshotHistory&, const std::size_t)>&
+        quantity) noexcept {
+  Plot plot{{"Game Number"}, y_axis, {}};
+  for (const Faction& faction : factions) {
+    if (faction.half().has_value() && faction.half().value() == half
+        && faction.color().has_value()) {
+      plot.series.push_back(snapshot_history_series(
+          label(faction.name()), faction.color().value(), faction.snapshots(),
+          quantity));
+    }
+  }
+  plot.autoscale_x_axis();
+  return plot;
+}
+
+PlotAxis ratings_axis(
+    const EloRating& lowest, const EloRating& highest) noexcept {
+  const int64_t increment{100};
+  const double minimum{static_cast<double>(
+      std::min(static_cast<int64_t>(EloRating{}.value() - increment),
+               nearest_lower_nice_number(lowest.value(), increment)))};
+  const double maximum{static_cast<double>(
+      std::max(static_cast<int64_t>(EloRating{}.value() + increment),
+               nearest_higher_nice_number(highest.value(), increment)))};
+  return {"Rating", minimum, maximum, nice_increment(maximum - minimum), 5};
+}
+
+const PlotAxis PointsAxis{
+    "Average Victory Points per Game", 4.0, 11.0, 1.0, 5};
+
+const PlotAxis WinRatesAxis{
+    "Effective Win Rate Percentage", 0.0, 100.0, 10.0, 5};
+
+double current_elo_rating(
+    const SnapshotHistory& history, const std::size_t index) noexcept {
+  return history.current_elo_ratings()[index].value();
+}
+
+double average_victory_points_per_game(
+    const SnapshotHistory& history, const std::size_t index) noexcept {
+  return history.average_victory_points_per_game()[index];
+}
+
+double effective_win_rate_percentage(
+    const SnapshotHistory& history, const std::size_t index) noexcept {
+  return 100.0 * history.effective_win_rates()[index].value();
+}
+
+}  // namespace
+
+/// \brief Plot of the current rating of each player versus the game number.
+Plot ratings_plot(const Players& players) noexcept {
+  return snapshot_histories_plot(
+      players,
+      ratings_axis(players.lowest_elo_rating(), players.highest_elo_rating()),
+      current_elo_rating);
+}
+
+/// \brief Plot of the current rating of each faction in a given half versus
+/// the game number.
+Plot ratings_plot(const Factions& factions, const Half half) noexcept {
+  return snapshot_histories_plot(
+      factions, half,
+      ratings_axis(factions.lowest_elo_rating(), factions.highest_elo_rating()),
+      current_elo_rating);
+}
+
+/// \brief Plot of the average victory points per game of each player versus
+/// the game number.
+Plot points_plot(const Players& players) noexcept {
+  return snapshot_histories_plot(
+      players, PointsAxis, average_victory_points_per_game);
+}
+
+/// \brief Plot of the average victory points per game of each faction in a
+/// given half versus the game number.
+Plot points_plot(const Factions& factions, const Half half) noexcept {
+  return snapshot_histories_plot(
+      factions, half, PointsAxis, average_victory_points_per_game);
+}
+
+/// \brief Plot of the effective win rate of each player versus the game
+/// number.
+Plot win_rates_plot(const Players& players) noexcept {
+  return snapshot_histories_plot(
+      players, WinRatesAxis, effective_win_rate_percentage);
+}
+
+/// \brief Plot of the effective win rate of each faction in a given half
+/// versus the game number.
+Plot win_rates_plot(const Factions& factions, const Half half) noexcept {
+  return snapshot_histories_plot(
+      factions, half, WinRatesAxis, effective_win_rate_percentage);
+}
+
+/// \brief Plot of the duration of each game versus its number of players,
+/// along with its linear regression fit.
+Plot duration_plot(const Games& games) noexcept {
+  const GamesDurationVersusNumberOfPlayers& duration{
+      games.duration_versus_number_of_players()};
+  const int64_t increment{1};
+  Plot plot{{"Number of Players",
+             static_cast<double>(PlotMinimumNumberOfPlayers),
+             static_cast<double>(PlotMaximumNumberOfPlayers),
+             static_cast<double>(increment), 1},
+            {"Game Duration in Hours",
+             static_cast<double>(std::max(
+                 static_cast<int64_t>(0),
+                 nearest_lower_nice_number(
+                     duration.minimum_duration_in_hours(), increment))),
+             static_cast<double>(std::max(
+                 increment,
+                 nearest_higher_nice_number(
+                     duration.maximum_duration_in_hours(), increment))),
+             static_cast<double>(increment), 4},
+            {}};
+  PlotSeries values{"", Color::Black, true, {}};
+  for (const std::pair<double, double>& number_of_players_and_duration :
+       duration) {
+    values.points.push_back(number_of_players_and_duration);
+  }
+  plot.series.push_back(values);
+  PlotSeries fit{duration.print(), Color::Black, false, {}};
+  for (const std::size_t number_of_players :
+       {PlotMinimumNumberOfPlayers, PlotMaximumNumberOfPlayers}) {
+    fit.points.emplace_back(
+        static_cast<double>(number_of_players),
+        duration.linear_regression()(
+            static_cast<double>(number_of_players)));
+  }
+  plot.series.push_back(fit);
+  return plot;
+}
+
+}  // namespace TI4Echelon
@@ -25,6 +25,7 @@ public:
              + player.name().value() + "\" , \\");
       }
     }
+    write();
   }
 
   PointsPlotConfigurationFileWriter(const std::filesystem::path& directory,
@@ -47,6 +48,7 @@ public:
              + label(faction.name()) + "\" , \\");
       }
     }
+    write();
   }
 
 private:
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Profiler.hpp"
+#include "TextFileWriter.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Writes the phases recorded by a profiler to a JSON file.
+class ProfileFileWriter : public TextFileWriter {
+public:
+  ProfileFileWriter(const std::filesystem::path& path, const Profiler& profiler)
+    : TextFileWriter(path) {
+    line("{");
+    line("  \"phases\": [");
+    const std::vector<ProfilePhase>& phases{profiler.phases()};
+    for (std::size_t index = 0; index < phases.size(); ++index) {
+      const ProfilePhase& phase{phases[index]};
+      line("    {");
+      line("      \"name\": \"" + phase.name + "\",");
+      line("      \"depth\": " + std::to_string(phase.depth) + ",");
+      line("      \"wall_time_seconds\": "
+           + real_number_to_string(phase.wall_time, 6) + ",");
+      line("      \"cpu_time_seconds\": "
+           + real_number_to_string(phase.cpu_time, 6) + ",");
+      line("      \"peak_resident_set_size_kibibytes\": "
+           + std::to_string(phase.peak_resident_set_size) + ",");
+      line("      \"allocations\": " + std::to_string(phase.allocations));
+      line(std::string{"    }"} + (index + 1 < phases.size() ? "," : ""));
+    }
+    line("  ]");
+    line("}");
+    write();
+  }
+
+};  // class ProfileFileWriter
+
+}  // namespace TI4Echelon
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <sys/resource.h>
+
+#include "AllocationCount.hpp"
+#include "Table.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Resource usage of a single phase of the program. Each measurement
+/// includes the phases nested within it.
+struct ProfilePhase {
+  std::string name;
+
+  /// \brief Nesting depth of the phase. Top-level phases have depth 0.
+  std::size_t depth{0};
+
+  /// \brief Elapsed wall-clock time in seconds.
+  double wall_time{0.0};
+
+  /// \brief User and system CPU time in seconds, summed over all threads.
+  double cpu_time{0.0};
+
+  /// \brief Peak resident set size of the program at the end of the phase, in
+  /// kibibytes.
+  std::size_t peak_resident_set_size{0};
+
+  /// \brief Number of heap allocations performed during the phase.
+  std::size_t allocations{0};
+};
+
+/// \brief Global profiler that records the wall time, CPU time, peak resident
+/// set size, and number of heap allocations of each phase of the program.
+/// \details The profiler is disabled by default, in which case measuring a
+/// phase does nothing. Phases are listed in the order in which they begin.
+class Profiler {
+public:
+  static Profiler& get() noexcept {
+    static Profiler profiler;
+    return profiler;
+  }
+
+  Profiler(const Profiler&) = delete;
+
+  Profiler& operator=(const Profiler&) = delete;
+
+  bool enabled() const noexcept {
+    return enabled_;
+  }
+
+  void enable() noexcept {
+    enabled_ = true;
+    CountAllocations.store(true, std::memory_order_relaxed);
+  }
+
+  const std::vector<ProfilePhase>& phases() const noexcept {
+    return phases_;
+  }
+
+  /// \brief Begins measuring a phase. Returns the index of the phase, which
+  /// must later be passed to end().
+  std::size_t begin(const std::string& name) noexcept {
+    phases_.push_back({name, depth_});
+    starts_.push_back(now());
+    ++depth_;
+    return phases_.size() - 1;
+  }
+
+  /// \brief Ends measuring the phase with a given index.
+  void end(const std::size_t index) noexcept {
+    const Measurement finish{now()};
+    const Measurement& start{starts_[index]};
+    ProfilePhase& phase{phases_[index]};
+    phase.wall_time =
+        std::chrono::duration<double>(finish.wall_time - start.wall_time)
+            .count();
+    phase.cpu_time = finish.cpu_time - start.cpu_time;
+    phase.peak_resident_set_size = finish.peak_resident_set_size;
+    phase.allocations = finish.allocations - start.allocations;
+    --depth_;
+  }
+
+  /// \brief Summary table of the phases. Nested phases are indented.
+  Table table() const noexcept {
+    Table table;
+    table.insert_column("Phase", Alignment::Left);
+    table.insert_column("Wall Time (s)", Alignment::Right);
+    table.insert_column("CPU Time (s)", Alignment::Right);
+    table.insert_column("Peak RSS (MiB)", Alignment::Right);
+    table.insert_column("Allocations", Alignment::Right);
+    for (const ProfilePhase& phase : phases_) {
+      table.column(0).insert_row(
+          std::string(2 * phase.depth, ' ') + phase.name);
+      table.column(1).insert_row({phase.wall_time, 3});
+      table.column(2).insert_row({phase.cpu_time, 3});
+      table.column(3).insert_row(
+          {static_cast<double>(phase.peak_resident_set_size) / 1024.0, 1});
+      table.column(4).insert_row(phase.allocations);
+    }
+    return table;
+  }
+
+  /// \brief Prints the summary table to the console.
+  void report() const noexcept {
+    message("Profile:\n" + table().print_as_markdown());
+  }
+
+private:
+  /// \brief Resource usage at an instant.
+  struct Measurement {
+    std::chrono::steady_clock::time_point wall_time;
+
+    double cpu_time{0.0};
+
+    std::size_t peak_resident_set_size{0};
+
+    std::size_t allocations{0};
+  };
+
+  Profiler() noexcept {}
+
+  bool enabled_{false};
+
+  std::size_t depth_{0};
+
+  std::vector<ProfilePhase> phases_;
+
+  /// \brief Resource usage at the beginning of each phase, indexed in the same
+  /// way as the phases.
+  std::vector<Measurement> starts_;
+
+  static Measurement now() noexcept {
+    Measurement measurement;
+    measurement.wall_time = std::chrono::steady_clock::now();
+    struct rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+      measurement.cpu_time =
+          static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+          + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec)
+                * 1.0e-6;
+      measurement.peak_resident_set_size =
+          static_cast<std::size_t>(usage.ru_maxrss);
+    }
+    measurement.allocations =
+        NumberOfAllocations.load(std::memory_order_relaxed);
+    return measurement;
+  }
+
+};  // class Profiler
+
+/// \brief Measures a phase of the program from its construction to its
+/// destruction if the global profiler is enabled. Does nothing otherwise.
+class ProfilerScope {
+public:
+  ProfilerScope(const std::string& name) noexcept {
+    if (Profiler::get().enabled()) {
+      index_ = Profiler::get().begin(name);
+    }
+  }
+
+  ProfilerScope(const ProfilerScope&) = delete;
+
+  ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+  ~ProfilerScope() noexcept {
+    if (index_.has_value()) {
+      Profiler::get().end(index_.value());
+    }
+  }
+
+private:
+  std::optional<std::size_t> index_;
+
+};  // class ProfilerScope
+
+}  // namespace TI4Echelon
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "Factions.hpp"
+#include "Games.hpp"
+#include "JsonWriter.hpp"
+#include "Players.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Immutable version of the games, players, and factions that queries
+/// read. A new version is published whenever the games change, while queries
+/// that are still reading the previous version keep it alive.
+struct QueryState {
+  Games games;
+
+  Players players;
+
+  Factions factions;
+};
+
+/// \brief Response to a query of the leaderboard state, given the target of an
+/// HTTP GET request. The body is a JSON document.
+/// \details The supported targets are:
+/// - /players?offset=<number>&limit=<number>: players ranked by average rating,
+///   as in the leaderboard.
+/// - /players/<name>: statistics and snapshot history of one player.
+/// - /factions?offset=<number>&limit=<number>: factions ranked by average
+///   rating, as in the leaderboard.
+/// - /factions/<name>: statistics and snapshot history of one faction.
+/// - /games?offset=<number>&limit=<number>: games from most recent to oldest.
+/// The offset and limit are optional and default to the whole list.
+class QueryResponse {
+public:
+  QueryResponse(const QueryState& state, const std::string& target) noexcept {
+    const std::string::size_type question_mark{target.find('?')};
+    const std::vector<std::string> segments{
+        path_segments(target.substr(0, question_mark))};
+    const std::map<std::string, std::string> parameters{query_parameters(
+        question_mark != std::string::npos ? target.substr(question_mark + 1) :
+                                             std::string{})};
+    if (segments.size() == 1 && segments[0] == "players") {
+      ranking("players", state.players, parameters);
+    } else if (segments.size() == 2 && segments[0] == "players") {
+      player(state.players, segments[1]);
+    } else if (segments.size() == 1 && segments[0] == "factions") {
+      ranking("factions", state.factions, parameters);
+    } else if (segments.size() == 2 && segments[0] == "factions") {
+      faction(state.factions, segments[1]);
+    } else if (segments.size() == 1 && segments[0] == "games") {
+      games(state.games, parameters);
+    } else {
+      not_found("There is no resource at '" + target + "'.");
+    }
+  }
+
+  /// \brief HTTP status code of the response.
+  int status() const noexcept {
+    return status_;
+  }
+
+  const std::string& body() const noexcept {
+    return json_.text();
+  }
+
+  /// \brief Writes the members of the latest statistics of a player or
+  /// faction to the current object of a JSON document.
+  static void statistics(JsonWriter& json, const Snapshot& snapshot) noexcept {
+    json.key("games").value(
+        static_cast<uint64_t>(snapshot.local_game_number()));
+    json.key("current_rating").value(snapshot.current_elo_rating().value(), 2);
+    json.key("average_rating").value(snapshot.average_elo_rating().value(), 2);
+    json.key("average_points").value(
+        snapshot.average_victory_points_per_game(), 2);
+    json.key("effective_win_rate")
+        .value(snapshot.effective_win_rate().value(), 4);
+    json.key("first_places")
+        .value(static_cast<uint64_t>(snapshot.place_count({1})));
+    json.key("second_places")
+        .value(static_cast<uint64_t>(snapshot.place_count({2})));
+    json.key("third_places")
+        .value(static_cast<uint64_t>(snapshot.place_count({3})));
+  }
+
+  /// \brief Sorts players or factions by average rating in descending order,
+  /// as in the leaderboard.
+  template <typename Entity>
+  static void rank(std::vector<const Entity*>& entities) noexcept {
+    std::stable_sort(entities.begin(), entities.end(),
+                     [](const Entity* entity_1, const Entity* entity_2) {
+                       return entity_1->latest_snapshot()->average_elo_rating()
+                              > entity_2->latest_snapshot()
+                                    ->average_elo_rating();
+                     });
+  }
+
+  /// \brief Writes the history of a player or faction in chronological order.
+  static void history(
+      JsonWriter& json, const SnapshotHistory& snapshots) noexcept {
+    json.key("history").begin_array();
+    for (std::size_t index = 0; index < snapshots.size(); ++index) {
+      json.begin_object();
+      json.key("game").value(
+          static_cast<uint64_t>(snapshots.global_game_numbers()[index]));
+      json.key("date").value(snapshots.dates()[index]);
+      json.key("current_rating")
+          .value(snapshots.current_elo_ratings()[index].value(), 2);
+      json.key("average_rating")
+          .value(snapshots.average_elo_ratings()[index].value(), 2);
+      json.key("average_points")
+          .value(snapshots.average_victory_points_per_game()[index], 2);
+      json.key("effective_win_rate")
+          .value(snapshots.effective_win_rates()[index].value(), 4);
+      json.end_object();
+    }
+    json.end_array();
+  }
+
+private:
+  int status_{200};
+
+  JsonWriter json_;
+
+  void not_found(const std::string& text) noexcept {
+    status_ = 404;
+    json_.begin_object().key("error").value(text).end_object();
+  }
+
+  void bad_request(const std::string& text) noexcept {
+    status_ = 400;
+    json_.begin_object().key("error").value(text).end_object();
+  }
+
+  /// \brief Writes the players or factions ranked by average rating, from a
+  /// given offset and up to a given limit.
+  template <typename Entities>
+  void ranking(const std::string& key, const Entities& entities,
+               const std::map<std::string, std::string>& parameters) noexcept {
+    std::vector<const std::decay_t<decltype(*entities.cbegin())>*> ranked;
+    for (const auto& entity : entities) {
+      if (entity.latest_snapshot() != nullptr) {
+        ranked.push_back(&entity);
+      }
+    }
+    const std::optional<std::pair<std::size_t, std::size_t>> range{
+        page(parameters, ranked.size())};
+    if (!range.has_value()) {
+      return;
+    }
+    rank(ranked);
+    json_.begin_object();
+    json_.key("total").value(static_cast<uint64_t>(ranked.size()));
+    json_.key(key).begin_array();
+    for (std::size_t index = range.value().first;
+         index < range.value().second; ++index) {
+      json_.begin_object();
+      json_.key("rank").value(static_cast<uint64_t>(index + 1));
+      json_.key("name").value(name(*ranked[index]));
+      statistics(json_, *ranked[index]->latest_snapshot());
+      json_.end_object();
+    }
+    json_.end_array().end_object();
+  }
+
+  void player(const Players& players_, const std::string& name) noexcept {
+    const std::optional<PlayerName> player_name{PlayerName::find(name)};
+    const Players::const_iterator found{
+        player_name.has_value() ? players_.find(player_name.value()) :
+                                  players_.cend()};
+    if (found == players_.cend() || found->latest_snapshot() == nullptr) {
+      not_found("There is no player named '" + name + "'.");
+      return;
+    }
+    json_.begin_object();
+    json_.key("name").value(found->name().value());
+    statistics(json_, *found->latest_snapshot());
+    history(json_, found->snapshots());
+    json_.end_object();
+  }
+
+  void faction(const Factions& factions_, const std::string& name) noexcept {
+    Factions::const_iterator found{factions_.cend()};
+    const std::optional<FactionName> faction_name{type<FactionName>(name)};
+    if (faction_name.has_value()) {
+      found = factions_.find(faction_name.value());
+    } else {
+      // Also accept the name used for the faction's leaderboard directory.
+      for (Factions::const_iterator faction_ = factions_.cbegin();
+           faction_ != factions_.cend(); ++faction_) {
+        if (path(faction_->name()).string() == name) {
+          found = faction_;
+          break;
+        }
+      }
+    }
+    if (found == factions_.cend() || found->latest_snapshot() == nullptr) {
+      not_found("There is no faction named '" + name + "'.");
+      return;
+    }
+    json_.begin_object();
+    json_.key("name").value(label(found->name()));
+    statistics(json_, *found->latest_snapshot());
+    history(json_, found->snapshots());
+    json_.end_object();
+  }
+
+  void games(const Games& games_,
+             const std::map<std::string, std::string>& parameters) noexcept {
+    const std::optional<std::pair<std::size_t, std::size_t>> range{
+        page(parameters, games_.size())};
+    if (!range.has_value()) {
+      return;
+    }
+    const Games::const_iterator first{
+        games_.cbegin() + static_cast<std::ptrdiff_t>(range.value().first)};
+    const Games::const_iterator last{
+        games_.cbegin() + static_cast<std::ptrdiff_t>(range.value().second)};
+    json_.begin_object();
+    json_.key("total").value(static_cast<uint64_t>(games_.size()));
+    json_.key("games").begin_array();
+    for (Games::const_iterator game{first}; game != last; ++game) {
+      json_.begin_object();
+      json_.key("game").value(static_cast<uint64_t>(game->index() + 1));
+      json_.key("date").value(game->date());
+      json_.key("mode").value(label(game->mode()));
+      json_.key("points").value(game->victory_point_goal().value());
+      json_.key("duration_hours");
+      if (game->duration().has_value()) {
+        json_.value(game->duration().value().hours(), 2);
+      } else {
+        json_.null();
+      }
+      json_.key("participants").begin_array();
+      for (const Participant& participant : game->participants()) {
+        json_.begin_object();
+        json_.key("place").value(
+            static_cast<uint64_t>(participant.place().value()));
+        json_.key("player").value(participant.player_name().value());
+        json_.key("points").value(participant.victory_points().value());
+        json_.key("faction").value(label(participant.faction_name()));
+        json_.end_object();
+      }
+      json_.end_array().end_object();
+    }
+    json_.end_array().end_object();
+  }
+
+  /// \brief Range of indices, from the first to one past the last, of a list
+  /// of a given size selected by the offset and limit query parameters. Both
+  /// default to the whole list. Answers with an error and returns no value if
+  /// either of them is not a non-negative integer.
+  std::optional<std::pair<std::size_t, std::size_t>> page(
+      const std::map<std::string, std::string>& parameters,
+      const std::size_t size) noexcept {
+    std::optional<std::size_t> offset{0};
+    std::optional<std::size_t> limit{size};
+    for (const std::pair<const std::string, std::string>& parameter :
+         parameters) {
+      if (parameter.first == "offset") {
+        offset = count(parameter.second);
+      } else if (parameter.first == "limit") {
+        limit = count(parameter.second);
+      }
+    }
+    if (!offset.has_value() || !limit.has_value()) {
+      bad_request("The offset and limit must be non-negative integers.");
+      const std::optional<std::pair<std::size_t, std::size_t>> no_range;
+      return no_range;
+    }
+    const std::size_t first{std::min(offset.value(), size)};
+    return {{first, first + std::min(limit.value(), size - first)}};
+  }
+
+  static std::string name(const Player& player) noexcept {
+    return player.name().value();
+  }
+
+  static std::string name(const Faction& faction) noexcept {
+    return label(faction.name());
+  }
+
+  /// \brief Non-negative integer given as a query parameter, or no value if
+  /// the text is not one.
+  static std::optional<std::size_t> count(const std::string& text) noexcept {
+    const std::optional<int64_t> number{string_to_integer_number(text)};
+    if (number.has_value() && number.value() >= 0) {
+      return {static_cast<std::size_t>(number.value())};
+    } else {
+      const std::optional<std::size_t> no_count;
+      return no_count;
+    }
+  }
+
+  /// \brief Decoded, non-empty segments of the path of a request target.
+  static std::vector<std::string> path_segments(
+      const std::string& path_) noexcept {
+    std::vector<std::string> segments;
+    std::string::size_type begin{0};
+    while (begin <= path_.size()) {
+      std::string::size_type end{path_.find('/', begin)};
+      if (end == std::string::npos) {
+        end = path_.size();
+      }
+      if (end > begin) {
+        segments.push_back(decode(path_.substr(begin, end - begin)));
+      }
+      begin = end + 1;
+    }
+    return segments;
+  }
+
+  /// \brief Decoded parameters of the query string of a request target.
+  static std::map<std::string, std::string> query_parameters(
+      const std::string& query) noexcept {
+    std::map<std::string, std::string> parameters;
+    std::string::size_type begin{0};
+    while (begin < query.size()) {
+      std::string::size_type end{query.find('&', begin)};
+      if (end == std::string::npos) {
+        end = query.size();
+      }
+      const std::string parameter{query.substr(begin, end - begin)};
+      const std::string::size_type equals{parameter.find('=')};
+      if (equals != std::string::npos) {
+        parameters[decode(parameter.substr(0, equals))] =
+            decode(parameter.substr(equals + 1));
+      } else if (!parameter.empty()) {
+        parameters[decode(parameter)] = std::string{};
+      }
+      begin = end + 1;
+    }
+    return parameters;
+  }
+
+  /// \brief Decodes the percent-encoded characters of a URL component. A plus
+  /// sign is decoded as a space.
+  static std::string decode(const std::string& text) noexcept {
+    std::string decoded;
+    for (std::size_t index = 0; index < text.size(); ++index) {
+      if (text[index] == '%' && index + 2 < text.size()
+          && std::isxdigit(static_cast<unsigned char>(text[index + 1]))
+          && std::isxdigit(static_cast<unsigned char>(text[index + 2]))) {
+        decoded += static_cast<char>(
+            std::stoi(text.substr(index + 1, 2), nullptr, 16));
+        index += 2;
+      } else if (text[index] == '+') {
+        decoded += ' ';
+      } else {
+        decoded += text[index];
+      }
+    }
+    return decoded;
+  }
+
+};  // class QueryResponse
+
+}  // namespace TI4Echelon
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "QueryResponse.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Maximum size in bytes of the head of an HTTP request, i.e. of its
+/// request line and headers.
+constexpr const std::size_t MaximumRequestHeadSize{1 << 14};
+
+/// \brief Local HTTP server that answers queries of the leaderboard state with
+/// JSON documents. Only listens on the loopback interface.
+/// \details A single thread runs an epoll event loop over non-blocking sockets
+/// and answers each request from the latest published version of the state.
+/// Versions are published read-copy-update style: the games, players, and
+/// factions are updated on a private copy, and the new version is then made
+/// visible by atomically swapping a reference-counted pointer. Queries thus
+/// never wait for an update, and a query that is being answered keeps reading
+/// the version it started with, which is freed once its last reader is done.
+class QueryServer {
+public:
+  /// \brief Starts listening on a given port and serving queries of a given
+  /// version of the state.
+  QueryServer(const uint16_t port, std::shared_ptr<const QueryState> state)
+    : state_(std::move(state)) {
+    listener_ =
+        ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener_ < 0) {
+      error("Could not create the query server socket.");
+    }
+    const int enable{1};
+    ::setsockopt(listener_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(listener_, reinterpret_cast<const sockaddr*>(&address),
+               sizeof(address))
+            < 0
+        || ::listen(listener_, SOMAXCONN) < 0) {
+      ::close(listener_);
+      error("Could not listen on port " + std::to_string(port) + ".");
+    }
+    stop_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_ = ::epoll_create1(EPOLL_CLOEXEC);
+    try {
+      if (stop_ < 0 || epoll_ < 0) {
+        error("Could not initialize the query server event loop.");
+      }
+      watch(listener_, EPOLLIN, EPOLL_CTL_ADD);
+      watch(stop_, EPOLLIN, EPOLL_CTL_ADD);
+      thread_ = std::thread{[this] { run(); }};
+    } catch (...) {
+      close_descriptors();
+      throw;
+    }
+  }
+
+  QueryServer(const QueryServer&) = delete;
+
+  QueryServer& operator=(const QueryServer&) = delete;
+
+  /// \brief Stops the event loop and closes all connections.
+  ~QueryServer() noexcept {
+    const uint64_t one{1};
+    if (::write(stop_, &one, sizeof(one)) < 0) {
+      // The event loop has already stopped.
+    }
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    for (const std::pair<const int, Connection>& connection : connections_) {
+      ::close(connection.first);
+    }
+    close_descriptors();
+  }
+
+  /// \brief Makes a new version of the state visible to the queries received
+  /// from now on.
+  void publish(std::shared_ptr<const QueryState> state) noexcept {
+    std::atomic_store_explicit(
+        &state_, std::move(state), std::memory_order_release);
+  }
+
+  /// \brief Blocks until the event loop stops.
+  void wait() noexcept {
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+private:
+  /// \brief Buffered input and output of a client connection.
+  struct Connection {
+    std::string input;
+
+    std::string output;
+
+    /// \brief Number of bytes of the output already sent.
+    std::size_t sent{0};
+
+    /// \brief Whether to close the connection once the output is sent.
+    bool close{false};
+  };
+
+  int listener_{-1};
+
+  int stop_{-1};
+
+  int epoll_{-1};
+
+  std::thread thread_;
+
+  /// \brief Latest published version of the state. Only accessed atomically.
+  std::shared_ptr<const QueryState> state_;
+
+  /// \brief Client connections by socket. Only accessed by the event loop.
+  std::unordered_map<int, Connection> connections_;
+
+  /// \brief Closes the event loop and listening descriptors that are open.
+  void close_descriptors() noexcept {
+    for (const int descriptor : {epoll_, stop_, listener_}) {
+      if (descriptor >= 0) {
+        ::close(descriptor);
+      }
+    }
+  }
+
+  std::shared_ptr<const QueryState> state() const noexcept {
+    return std::atomic_load_explicit(&state_, std::memory_order_acquire);
+  }
+
+  void watch(const int socket, const uint32_t events, const int operation) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = socket;
+    if (::epoll_ctl(epoll_, operation, socket, &event) < 0) {
+      error("Could not watch a socket of the query server.");
+    }
+  }
+
+  void run() noexcept {
+    std::array<epoll_event, 64> events;
+    while (true) {
+      const int ready{::epoll_wait(
+          epoll_, events.data(), static_cast<int>(events.size()), -1)};
+      if (ready < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return;
+      }
+      for (int index = 0; index < ready; ++index) {
+        const int socket{events[index].data.fd};
+        if (socket == stop_) {
+          return;
+        } else if (socket == listener_) {
+          accept();
+        } else if ((events[index].events & (EPOLLHUP | EPOLLERR)) != 0) {
+          close(socket);
+        } else {
+          if ((events[index].events & EPOLLIN) != 0) {
+            receive(socket);
+          }
+          if ((events[index].events & EPOLLOUT) != 0 && send(socket)) {
+            answer(socket);
+          }
+        }
+      }
+    }
+  }
+
+  void accept() noexcept {
+    while (true) {
+      const int socket{
+          ::accept4(listener_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)};
+      if (socket < 0) {
+        return;
+      }
+      connections_.emplace(socket, Connection{});
+      try {
+        watch(socket, EPOLLIN, EPOLL_CTL_ADD);
+      } catch (const std::exception&) {
+        close(socket);
+      }
+    }
+  }
+
+  void close(const int socket) noexcept {
+    ::epoll_ctl(epoll_, EPOLL_CTL_DEL, socket, nullptr);
+    ::close(socket);
+    connections_.erase(socket);
+  }
+
+  /// \brief Reads the available input of a connection until the buffered
+  /// input exceeds the maximum size of a request head, and answers the
+  /// complete requests in it.
+  void receive(const int socket) noexcept {
+    const std::unordered_map<int, Connection>::iterator found{
+        connections_.find(socket)};
+    if (found == connections_.end()) {
+      return;
+    }
+    Connection& connection{found->second};
+    char buffer[4096];
+    while (connection.input.size() <= MaximumRequestHeadSize) {
+      const ssize_t length{::recv(socket, buffer, sizeof(buffer), 0)};
+      if (length > 0) {
+        connection.input.append(buffer, static_cast<std::size_t>(length));
+      } else if (length == 0
+                 || (errno != EAGAIN && errno != EWOULDBLOCK
+                     && errno != EINTR)) {
+        close(socket);
+        return;
+      } else if (errno != EINTR) {
+        break;
+      }
+    }
+    answer(socket);
+  }
+
+  /// \brief Answers the complete requests buffered in the input of a
+  /// connection, one at a time. The next request is only answered once the
+  /// answer to the previous one is sent, such that a client that sends
+  /// requests without reading the answers cannot make the output grow without
+  /// bound. In the meantime, no more input is read from the connection.
+  void answer(const int socket) noexcept {
+    const std::unordered_map<int, Connection>::iterator found{
+        connections_.find(socket)};
+    if (found == connections_.end()) {
+      return;
+    }
+    Connection& connection{found->second};
+    while (connection.output.empty() && !connection.close) {
+      const std::string::size_type end{connection.input.find("\r\n\r\n")};
+      if (end == std::string::npos) {
+        if (connection.input.size() > MaximumRequestHeadSize) {
+          connection.output += head(431, 0, true);
+          connection.close = true;
+          connection.input.clear();
+        }
+        send(socket);
+        return;
+      }
+      respond(connection, connection.input.substr(0, end));
+      connection.input.erase(0, end + 4);
+      if (!send(socket)) {
+        return;
+      }
+    }
+  }
+
+  /// \brief Sends as much of the pending output of a connection as possible.
+  /// Waits for the socket to be writable again if the output is not sent
+  /// entirely, without reading more input in the meantime. Returns whether the
+  /// connection is still open.
+  bool send(const int socket) noexcept {
+    const std::unordered_map<int, Connection>::iterator found{
+        connections_.find(socket)};
+    if (found == connections_.end()) {
+      return false;
+    }
+    Connection& connection{found->second};
+    while (connection.sent < connection.output.size()) {
+      const ssize_t length{
+          ::send(socket, connection.output.data() + connection.sent,
+                 connection.output.size() - connection.sent, MSG_NOSIGNAL)};
+      if (length > 0) {
+        connection.sent += static_cast<std::size_t>(length);
+      } else if (length < 0 && errno == EINTR) {
+        continue;
+      } else if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        ::epoll_event event{};
+        event.events = EPOLLOUT;
+        event.data.fd = socket;
+        ::epoll_ctl(epoll_, EPOLL_CTL_MOD, socket, &event);
+        return true;
+      } else {
+        close(socket);
+        return false;
+      }
+    }
+    connection.output.clear();
+    connection.sent = 0;
+    if (connection.close) {
+      close(socket);
+      return false;
+    }
+    ::epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = socket;
+    ::epoll_ctl(epoll_, EPOLL_CTL_MOD, socket, &event);
+    return true;
+  }
+
+  /// \brief Answers a request given its request line and headers. Only GET
+  /// requests without a body are supported.
+  void respond(Connection& connection, const std::string& request) noexcept {
+    const std::string::size_type line_end{request.find("\r\n")};
+    const std::string request_line{request.substr(0, line_end)};
+    const std::string::size_type first_space{request_line.find(' ')};
+    const std::string::size_type second_space{
+        request_line.find(' ', first_space + 1)};
+    if (first_space == std::string::npos
+        || second_space == std::string::npos) {
+      connection.output += head(400, 0, true);
+      connection.close = true;
+      return;
+    }
+    const std::string method{request_line.substr(0, first_space)};
+    const std::string target{request_line.substr(
+        first_space + 1, second_space - first_space - 1)};
+    const std::string version{request_line.substr(second_space + 1)};
+    std::string headers{
+        line_end != std::string::npos ? request.substr(line_end) : ""};
+    std::transform(headers.begin(), headers.end(), headers.begin(),
+                   [](const unsigned char character) {
+                     return static_cast<char>(std::tolower(character));
+                   });
+    connection.close = version != "HTTP/1.1"
+                       || headers.find("\r\nconnection: close")
+                              != std::string::npos;
+    if (method != "GET") {
+      connection.output += head(405, 0, true);
+      connection.close = true;
+      return;
+    }
+    const std::shared_ptr<const QueryState> state_of_query{state()};
+    const QueryResponse response{*state_of_query, target};
+    connection.output +=
+        head(response.status(), response.body().size(), connection.close);
+    connection.output += response.body();
+  }
+
+  /// \brief Status line and headers of a response with a JSON body of a given
+  /// size.
+  static std::string head(const int status, const std::size_t body_size,
+                          const bool close_connection) noexcept {
+    return "HTTP/1.1 " + std::to_string(status) + " " + reason(status)
+           + "\r\nContent-Type: application/json\r\nContent-Length: "
+           + std::to_string(body_size) + "\r\nConnection: "
+           + (close_connection ? "close" : "keep-alive") + "\r\n\r\n";
+  }
+
+  static std::string reason(const int status) noexcept {
+    switch (status) {
+      case 200:
+        return "OK";
+      case 400:
+        return "Bad Request";
+      case 404:
+        return "Not Found";
+      case 405:
+        return "Method Not Allowed";
+      case 431:
+        return "Request Header Fields Too Large";
+      default:
+        return "Error";
+    }
+  }
+
+};  // class QueryServer
+
+}  // namespace TI4Echelon
@@ -33,6 +33,7 @@ public:
              + player.name().value() + "\" , \\");
       }
     }
+    write();
   }
 
   RatingsPlotConfigurationFileWriter(const std::filesystem::path& directory,
@@ -63,6 +64,7 @@ public:
              + label(faction.name()) + "\" , \\");
       }
     }
+    write();
   }
 
 private:
@@ -12,32 +12,52 @@ public:
   /// \brief Default constructor. Does not initialize anything.
   Snapshot() noexcept {}
 
+  /// \brief Constructs a player's snapshot given a game in which the player
+  /// participated, the player's updated Elo rating after that game, and the
+  /// player's previous snapshot, if any.
   Snapshot(const PlayerName& player_name, const Game& game,
-           const std::unordered_map<PlayerName, EloRating>& elo_ratings,
-           const std::optional<Snapshot>& previous) noexcept
+           const EloRating& current_elo_rating,
+           const Snapshot* const previous) noexcept
     : global_game_index_(game.index()), date_(game.date()) {
     initialize_local_game_index(previous);
     initialize_average_victory_points_per_game(player_name, game, previous);
     initialize_place_counts(player_name, game, previous);
-    initialize_place_percentages();
     initialize_effective_win_rate(player_name, game, previous);
-    initialize_current_elo_rating(player_name, game, elo_ratings);
+    current_elo_rating_ = current_elo_rating;
     initialize_average_elo_rating(previous);
   }
 
+  /// \brief Constructs a faction's snapshot given a game in which the faction
+  /// participated, the faction's updated Elo rating after that game, and the
+  /// faction's previous snapshot, if any.
   Snapshot(const FactionName faction_name, const Game& game,
-           const std::unordered_map<FactionName, EloRating>& elo_ratings,
-           const std::optional<Snapshot>& previous) noexcept
+           const EloRating& current_elo_rating,
+           const Snapshot* const previous) noexcept
     : global_game_index_(game.index()), date_(game.date()) {
     initialize_local_game_index(previous);
     initialize_average_victory_points_per_game(faction_name, game, previous);
     initialize_place_counts(faction_name, game, previous);
-    initialize_place_percentages();
     initialize_effective_win_rate(faction_name, game, previous);
-    initialize_current_elo_rating(faction_name, game, elo_ratings);
+    current_elo_rating_ = current_elo_rating;
     initialize_average_elo_rating(previous);
   }
 
+  /// \brief Constructs a snapshot directly from its statistics, such as when
+  /// restoring a snapshot history from a checkpoint.
+  Snapshot(const std::size_t global_game_index,
+           const std::size_t local_game_index, const Date& date,
+           const double average_victory_points_per_game,
+           const std::array<uint32_t, MaximumPlace>& place_counts,
+           const Percentage& effective_win_rate,
+           const EloRating& current_elo_rating,
+           const EloRating& average_elo_rating) noexcept
+    : global_game_index_(global_game_index),
+      local_game_index_(local_game_index), date_(date),
+      average_victory_points_per_game_(average_victory_points_per_game),
+      place_counts_(place_counts), effective_win_rate_(effective_win_rate),
+      current_elo_rating_(current_elo_rating),
+      average_elo_rating_(average_elo_rating) {}
+
   /// \brief Global number of games played, including this one, at this time.
   constexpr std::size_t global_game_number() const noexcept {
     return global_game_index_ + 1;
@@ -59,24 +79,17 @@ public:
 
   /// \brief Number of Nth place finishes.
   std::size_t place_count(const Place place) const noexcept {
-    const std::map<Place, std::size_t, Place::sort>::const_iterator found{
-        place_counts_.find(place)};
-    if (found != place_counts_.cend()) {
-      return found->second;
+    if (place >= Place{1} && place <= Place{MaximumPlace}) {
+      return place_counts_[place.value() - 1];
     } else {
       return 0;
     }
   }
 
-  /// \brief Percentage ratio of Nth place finishes.
+  /// \brief Percentage ratio of Nth place finishes. Derived on demand from the
+  /// number of Nth place finishes.
   Percentage place_percentage(const Place place) const noexcept {
-    const std::map<Place, Percentage, Place::sort>::const_iterator found{
-        place_percentages_.find(place)};
-    if (found != place_percentages_.cend()) {
-      return found->second;
-    } else {
-      return {0.0};
-    }
+    return {static_cast<double>(place_count(place)) / local_game_number()};
   }
 
   std::string print_place_percentage_and_count(
@@ -130,9 +143,9 @@ private:
   /// adjusted to a 10-point game.
   double average_victory_points_per_game_{0.0};
 
-  std::map<Place, std::size_t, Place::sort> place_counts_;
-
-  std::map<Place, Percentage, Place::sort> place_percentages_;
+  /// \brief Number of Nth place finishes, indexed by N - 1. Stored inline such
+  /// that a snapshot is trivially copyable and does not allocate.
+  std::array<uint32_t, MaximumPlace> place_counts_{};
 
   /// \brief This is the efective win rate as if each game was a 6-player game.
   Percentage effective_win_rate_;
@@ -142,22 +155,22 @@ private:
   EloRating average_elo_rating_;
 
   void initialize_local_game_index(
-      const std::optional<Snapshot>& previous) noexcept {
-    if (previous.has_value()) {
-      local_game_index_ = previous.value().local_game_index_ + 1;
+      const Snapshot* const previous) noexcept {
+    if (previous != nullptr) {
+      local_game_index_ = previous->local_game_index_ + 1;
     }
   }
 
   void initialize_average_victory_points_per_game(
       const PlayerName& player_name, const Game& game,
-      const std::optional<Snapshot>& previous) noexcept {
+      const Snapshot* const previous) noexcept {
     const std::optional<double> adjusted_victory_points{
         game.adjusted_victory_points(player_name)};
     if (adjusted_victory_points.has_value()) {
-      if (previous.has_value()) {
+      if (previous != nullptr) {
         average_victory_points_per_game_ =
-            (previous.value().average_victory_points_per_game_
-                 * previous.value().local_game_number()
+            (previous->average_victory_points_per_game_
+                 * previous->local_game_number()
              + adjusted_victory_points.value())
             / local_game_number();
       } else {
@@ -171,19 +184,19 @@ private:
 
   void initialize_average_victory_points_per_game(
       const FactionName faction_name, const Game& game,
-      const std::optional<Snapshot>& previous) noexcept {
-    const std::multiset<double, std::greater<double>> adjusted_victory_points{
-        game.adjusted_victory_points(faction_name)};
+      const Snapshot* const previous) noexcept {
+    const StaticVector<double, MaximumNumberOfParticipants>
+        adjusted_victory_points{game.adjusted_victory_points(faction_name)};
     if (!adjusted_victory_points.empty()) {
       double average_adjusted_victory_points{0.0};
       for (const double value : adjusted_victory_points) {
         average_adjusted_victory_points += value;
       }
       average_adjusted_victory_points /= adjusted_victory_points.size();
-      if (previous.has_value()) {
+      if (previous != nullptr) {
         average_victory_points_per_game_ =
-            (previous.value().average_victory_points_per_game_
-                 * previous.value().local_game_number()
+            (previous->average_victory_points_per_game_
+                 * previous->local_game_number()
              + average_adjusted_victory_points)
             / local_game_number();
       } else {
@@ -195,43 +208,30 @@ private:
     }
   }
 
-  void initialize_place_counts(
-      const PlayerName& player_name, const Game& game,
-      const std::optional<Snapshot>& previous) noexcept {
-    if (previous.has_value()) {
-      place_counts_ = previous.value().place_counts_;
+  void initialize_place_counts(const PlayerName& player_name, const Game& game,
+                               const Snapshot* const previous) noexcept {
+    if (previous != nullptr) {
+      place_counts_ = previous->place_counts_;
     }
     const std::optional<Place> place{game.place(player_name)};
     if (place.has_value()) {
-      const std::map<Place, std::size_t, Place::sort>::iterator place_count{
-          place_counts_.find(place.value())};
-      if (place_count != place_counts_.end()) {
-        ++(place_count->second);
-      } else {
-        place_counts_.emplace(place.value(), 1);
-      }
+      ++place_counts_[place.value().value() - 1];
     } else {
       error("Player '" + player_name.value()
             + "' is not a participant in the game '" + game.print() + "'.");
     }
   }
 
-  void initialize_place_counts(
-      const FactionName faction_name, const Game& game,
-      const std::optional<Snapshot>& previous) noexcept {
-    if (previous.has_value()) {
-      place_counts_ = previous.value().place_counts_;
+  void initialize_place_counts(const FactionName faction_name, const Game& game,
+                               const Snapshot* const previous) noexcept {
+    if (previous != nullptr) {
+      place_counts_ = previous->place_counts_;
     }
-    const std::set<Place, Place::sort> places{game.places(faction_name)};
+    const StaticVector<Place, MaximumNumberOfParticipants> places{
+        game.places(faction_name)};
     if (!places.empty()) {
       for (const Place& place : places) {
-        const std::map<Place, std::size_t, Place::sort>::iterator place_count{
-            place_counts_.find(place)};
-        if (place_count != place_counts_.end()) {
-          ++(place_count->second);
-        } else {
-          place_counts_.emplace(place, 1);
-        }
+        ++place_counts_[place.value() - 1];
       }
     } else {
       error("Faction '" + label(faction_name)
@@ -239,30 +239,21 @@ private:
     }
   }
 
-  void initialize_place_percentages() noexcept {
-    for (const std::pair<const Place, std::size_t>& place_count :
-         place_counts_) {
-      place_percentages_.insert(
-          {place_count.first,
-           {static_cast<double>(place_count.second) / local_game_number()}});
-    }
-  }
-
   void initialize_effective_win_rate(
       const PlayerName& player_name, const Game& game,
-      const std::optional<Snapshot>& previous) noexcept {
+      const Snapshot* const previous) noexcept {
     const std::optional<Place> place{game.place(player_name)};
-    if (previous.has_value()) {
+    if (previous != nullptr) {
       if (place.has_value()) {
         if (place.value() == Place{1}) {
           effective_win_rate_ =
-              (previous.value().effective_win_rate()
-                   * previous.value().local_game_number()
+              (previous->effective_win_rate()
+                   * previous->local_game_number()
                + Percentage{game.participants().size() / 6.0})
               / local_game_number();
         } else {
-          effective_win_rate_ = (previous.value().effective_win_rate()
-                                 * previous.value().local_game_number())
+          effective_win_rate_ = (previous->effective_win_rate()
+                                 * previous->local_game_number())
                                 / local_game_number();
         }
       }
@@ -275,45 +266,34 @@ private:
 
   void initialize_effective_win_rate(
       const FactionName faction_name, const Game& game,
-      const std::optional<Snapshot>& previous) noexcept {
-    const std::set<Place, Place::sort> places{game.places(faction_name)};
-    if (previous.has_value()) {
-      if (places.find(Place{1}) != places.cend()) {
+      const Snapshot* const previous) noexcept {
+    const StaticVector<Place, MaximumNumberOfParticipants> places{
+        game.places(faction_name)};
+    if (previous != nullptr) {
+      if (places.contains(Place{1})) {
         effective_win_rate_ =
-            (previous.value().effective_win_rate()
-                 * previous.value().local_game_number()
+            (previous->effective_win_rate()
+                 * previous->local_game_number()
              + Percentage{game.participants().size() / 6.0})
             / local_game_number();
       } else {
-        effective_win_rate_ = (previous.value().effective_win_rate()
-                               * previous.value().local_game_number())
+        effective_win_rate_ = (previous->effective_win_rate()
+                               * previous->local_game_number())
                               / local_game_number();
       }
     } else {
-      if (places.find(Place{1}) != places.cend()) {
+      if (places.contains(Place{1})) {
         effective_win_rate_ = {game.participants().size() / 6.0};
       }
     }
   }
 
-  void initialize_current_elo_rating(
-      const PlayerName& player_name, const Game& game,
-      const std::unordered_map<PlayerName, EloRating>& elo_ratings) noexcept {
-    current_elo_rating_ = {player_name, game, elo_ratings};
-  }
-
-  void initialize_current_elo_rating(
-      const FactionName faction_name, const Game& game,
-      const std::unordered_map<FactionName, EloRating>& elo_ratings) noexcept {
-    current_elo_rating_ = {faction_name, game, elo_ratings};
-  }
-
   void initialize_average_elo_rating(
-      const std::optional<Snapshot>& previous) noexcept {
-    if (previous.has_value()) {
+      const Snapshot* const previous) noexcept {
+    if (previous != nullptr) {
       average_elo_rating_ =
-          (previous.value().average_elo_rating_
-               * previous.value().local_game_number()
+          (previous->average_elo_rating_
+               * previous->local_game_number()
            + current_elo_rating_)
           / (local_game_number());
     } else {
@@ -323,4 +303,7 @@ private:
 
 };  // class Snapshot
 
+static_assert(std::is_trivially_copyable<Snapshot>::value,
+              "Snapshots must be trivially copyable.");
+
 }  // namespace TI4Echelon
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "BinaryFileReader.hpp"
+#include "BinaryFileWriter.hpp"
+#include "Snapshot.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Chronological history of an entity's snapshots, stored by column. An
+/// entity is either a player or a faction.
+/// \details Each statistic is stored in its own contiguous array, such that
+/// consumers that read only one or two statistics across the whole history
+/// stream through memory instead of striding over entire snapshots. The index
+/// of a snapshot in the history is its local game index, i.e. its local game
+/// number minus one. The latest snapshot is also kept whole so that it can be
+/// accessed and extended without reassembling it from the columns.
+class SnapshotHistory {
+public:
+  /// \brief Default constructor. Initializes an empty history.
+  SnapshotHistory() noexcept {}
+
+  bool empty() const noexcept {
+    return global_game_numbers_.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return global_game_numbers_.size();
+  }
+
+  /// \brief Latest snapshot, or a null pointer if the history is empty. The
+  /// snapshot is not copied.
+  const Snapshot* latest() const noexcept {
+    if (!empty()) {
+      return &latest_;
+    } else {
+      return nullptr;
+    }
+  }
+
+  /// \brief Appends a snapshot to the end of the history.
+  void push_back(const Snapshot& snapshot) {
+    global_game_numbers_.push_back(snapshot.global_game_number());
+    dates_.push_back(snapshot.date());
+    current_elo_ratings_.push_back(snapshot.current_elo_rating());
+    average_elo_ratings_.push_back(snapshot.average_elo_rating());
+    average_victory_points_per_game_.push_back(
+        snapshot.average_victory_points_per_game());
+    effective_win_rates_.push_back(snapshot.effective_win_rate());
+    for (int8_t place = 1; place <= MaximumPlace; ++place) {
+      place_counts_[place - 1].push_back(
+          static_cast<uint32_t>(snapshot.place_count({place})));
+    }
+    latest_ = snapshot;
+  }
+
+  /// \brief Global number of games played at the time of each snapshot.
+  const std::vector<std::size_t>& global_game_numbers() const noexcept {
+    return global_game_numbers_;
+  }
+
+  const std::vector<Date>& dates() const noexcept {
+    return dates_;
+  }
+
+  const std::vector<EloRating>& current_elo_ratings() const noexcept {
+    return current_elo_ratings_;
+  }
+
+  const std::vector<EloRating>& average_elo_ratings() const noexcept {
+    return average_elo_ratings_;
+  }
+
+  /// \brief Average victory points per game at the time of each snapshot,
+  /// adjusted relative to a 10-point game.
+  const std::vector<double>& average_victory_points_per_game() const noexcept {
+    return average_victory_points_per_game_;
+  }
+
+  const std::vector<Percentage>& effective_win_rates() const noexcept {
+    return effective_win_rates_;
+  }
+
+  /// \brief Number of Nth place finishes at the time of each snapshot.
+  const std::vector<uint32_t>& place_counts(const Place place) const {
+    if (place < Place{1} || place > Place{MaximumPlace}) {
+      error("'" + place.print() + "' is not a valid place.");
+    }
+    return place_counts_[place.value() - 1];
+  }
+
+  /// \brief Percentage ratio of Nth place finishes at the time of the snapshot
+  /// with a given index.
+  Percentage place_percentage(
+      const std::size_t index, const Place place) const {
+    return {static_cast<double>(place_counts(place)[index])
+            / static_cast<double>(index + 1)};
+  }
+
+  /// \brief Writes the columns of this history to a binary file.
+  void write(BinaryFileWriter& writer) const noexcept {
+    writer.values(global_game_numbers_);
+    // Dates are written field by field such that their padding bytes are not
+    // written.
+    writer.value<uint64_t>(dates_.size());
+    for (const Date& date : dates_) {
+      writer.value(date.year());
+      writer.value(date.month_number());
+      writer.value(date.day_number());
+    }
+    writer.values(current_elo_ratings_);
+    writer.values(average_elo_ratings_);
+    writer.values(average_victory_points_per_game_);
+    writer.values(effective_win_rates_);
+    for (const std::vector<uint32_t>& counts : place_counts_) {
+      writer.values(counts);
+    }
+  }
+
+  /// \brief Reads the columns of a history written to a binary file and
+  /// replaces this history with it. Returns whether the columns were read and
+  /// are consistent with one another.
+  bool read(BinaryFileReader& reader) noexcept {
+    global_game_numbers_ = reader.values<std::size_t>();
+    // Each date is written as a year and a month and day number.
+    dates_.resize(reader.count(sizeof(int64_t) + 2 * sizeof(int8_t)));
+    if (!reader.good()) {
+      return false;
+    }
+    for (Date& date : dates_) {
+      const int64_t year{reader.value<int64_t>()};
+      const int8_t month_number{reader.value<int8_t>()};
+      const int8_t day_number{reader.value<int8_t>()};
+      date = {static_cast<int16_t>(year), month_number, day_number};
+      if (!reader.good()) {
+        return false;
+      }
+    }
+    current_elo_ratings_ = reader.values<EloRating>();
+    average_elo_ratings_ = reader.values<EloRating>();
+    average_victory_points_per_game_ = reader.values<double>();
+    effective_win_rates_ = reader.values<Percentage>();
+    for (std::vector<uint32_t>& counts : place_counts_) {
+      counts = reader.values<uint32_t>();
+    }
+    if (!reader.good() || !consistent()) {
+      return false;
+    }
+    initialize_latest();
+    return true;
+  }
+
+  /// \brief Removes the snapshots after a given number of snapshots.
+  void truncate(const std::size_t size_) noexcept {
+    if (size_ < size()) {
+      global_game_numbers_.resize(size_);
+      dates_.resize(size_);
+      current_elo_ratings_.resize(size_);
+      average_elo_ratings_.resize(size_);
+      average_victory_points_per_game_.resize(size_);
+      effective_win_rates_.resize(size_);
+      for (std::vector<uint32_t>& counts : place_counts_) {
+        counts.resize(size_);
+      }
+      initialize_latest();
+    }
+  }
+
+private:
+  std::vector<std::size_t> global_game_numbers_;
+
+  std::vector<Date> dates_;
+
+  std::vector<EloRating> current_elo_ratings_;
+
+  std::vector<EloRating> average_elo_ratings_;
+
+  std::vector<double> average_victory_points_per_game_;
+
+  std::vector<Percentage> effective_win_rates_;
+
+  /// \brief Number of Nth place finishes, indexed by N - 1.
+  std::array<std::vector<uint32_t>, MaximumPlace> place_counts_;
+
+  Snapshot latest_;
+
+  /// \brief Reassembles the latest snapshot from the columns.
+  void initialize_latest() noexcept {
+    if (!empty()) {
+      const std::size_t index{size() - 1};
+      std::array<uint32_t, MaximumPlace> place_counts_of_latest;
+      for (std::size_t place = 0; place < place_counts_.size(); ++place) {
+        place_counts_of_latest[place] = place_counts_[place][index];
+      }
+      latest_ = {global_game_numbers_[index] - 1,
+                 index,
+                 dates_[index],
+                 average_victory_points_per_game_[index],
+                 place_counts_of_latest,
+                 effective_win_rates_[index],
+                 current_elo_ratings_[index],
+                 average_elo_ratings_[index]};
+    } else {
+      latest_ = {};
+    }
+  }
+
+  /// \brief Whether all columns have the same number of snapshots.
+  bool consistent() const noexcept {
+    const std::size_t size_{size()};
+    bool consistent_{
+        dates_.size() == size_ && current_elo_ratings_.size() == size_
+        && average_elo_ratings_.size() == size_
+        && average_victory_points_per_game_.size() == size_
+        && effective_win_rates_.size() == size_};
+    for (const std::vector<uint32_t>& counts : place_counts_) {
+      consistent_ = consistent_ && counts.size() == size_;
+    }
+    return consistent_ && (empty() || global_game_numbers_.front() > 0);
+  }
+
+};  // class SnapshotHistory
+
+}  // namespace TI4Echelon
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Snapshot.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Bytes at the start of every state file.
+constexpr const std::array<char, 16> StateFileSignature{
+    'T', 'I', '4', ' ', 'E', 'c', 'h', 'e', 'l', 'o', 'n', ' ', 's', 't', 'a',
+    't'};
+
+/// \brief Version of the state file format. State files of any other version
+/// are rejected.
+constexpr const uint32_t StateFileVersion{1};
+
+/// \brief Value written in the native byte order, such that a state file
+/// written on a machine with another byte order is rejected.
+constexpr const uint32_t StateFileByteOrderMark{0x01020304};
+
+/// \brief Alignment in bytes of every array of a state file.
+constexpr const uint64_t StateFileAlignment{8};
+
+/// \brief Location in a state file of the snapshot history of a player or
+/// faction. Every offset is in bytes from the start of the file, and every
+/// column holds one value per snapshot, in chronological order.
+struct StateFileEntity {
+  uint64_t name_offset{0};
+
+  uint64_t name_size{0};
+
+  uint64_t number_of_snapshots{0};
+
+  uint64_t global_game_numbers_offset{0};
+
+  uint64_t dates_offset{0};
+
+  uint64_t current_elo_ratings_offset{0};
+
+  uint64_t average_elo_ratings_offset{0};
+
+  uint64_t average_victory_points_per_game_offset{0};
+
+  uint64_t effective_win_rates_offset{0};
+
+  /// \brief Offsets of the numbers of Nth place finishes, indexed by N - 1.
+  std::array<uint64_t, MaximumPlace> place_counts_offsets{};
+};
+
+/// \brief Location in a state file of the players or of the factions, along
+/// with two indices of them: one sorted by name, to look up a name with a
+/// binary search, and one sorted by average Elo rating in descending order, as
+/// in the leaderboard, to list the top entities without sorting them.
+struct StateFileTable {
+  uint64_t number_of_entities{0};
+
+  /// \brief Offset of the array of StateFileEntity records.
+  uint64_t entities_offset{0};
+
+  /// \brief Offset of the array of entity indices sorted by name.
+  uint64_t by_name_offset{0};
+
+  /// \brief Number of entities with at least one snapshot, which are the only
+  /// ones that are ranked.
+  uint64_t number_of_ranked_entities{0};
+
+  /// \brief Offset of the array of entity indices sorted by average Elo rating
+  /// in descending order.
+  uint64_t by_rating_offset{0};
+};
+
+/// \brief Header at the start of a state file.
+struct StateFileHeader {
+  std::array<char, 16> signature{};
+
+  uint32_t version{0};
+
+  uint32_t byte_order_mark{0};
+
+  /// \brief Size of the whole file in bytes.
+  uint64_t size{0};
+
+  /// \brief Number of games from which the statistics were computed.
+  uint64_t number_of_games{0};
+
+  StateFileTable players;
+
+  StateFileTable factions;
+};
+
+/// \brief Read-only view of the player and faction statistics stored in a
+/// state file, which is mapped into memory rather than read.
+/// \details The layout of a state file is the in-memory layout of the
+/// statistics: a header, then for the players and the factions an array of
+/// fixed-size records and two arrays of indices, and finally the names and the
+/// columns of every snapshot history, each as a contiguous array of the same
+/// type as in a SnapshotHistory. Everything is located by its offset from the
+/// start of the file. Opening a state file only checks that these offsets lie
+/// within the file, which takes a time proportional to the number of players
+/// and factions but not to the number of games. Queries then read the mapping
+/// directly, without parsing or allocating anything. State files are written
+/// by a StateFileWriter in the native byte order and layout of the machine.
+class StateFile {
+public:
+  /// \brief View of the snapshot history of one player or faction.
+  class Entity {
+  public:
+    Entity(const char* const data, const StateFileEntity& record) noexcept
+      : data_(data), record_(&record) {}
+
+    std::string_view name() const noexcept {
+      return {data_ + record_->name_offset, record_->name_size};
+    }
+
+    /// \brief Number of snapshots, which is the number of games played.
+    std::size_t size() const noexcept {
+      return record_->number_of_snapshots;
+    }
+
+    bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    /// \brief Global number of games played at the time of each snapshot.
+    const std::size_t* global_game_numbers() const noexcept {
+      return column<std::size_t>(record_->global_game_numbers_offset);
+    }
+
+    const Date* dates() const noexcept {
+      return column<Date>(record_->dates_offset);
+    }
+
+    const EloRating* current_elo_ratings() const noexcept {
+      return column<EloRating>(record_->current_elo_ratings_offset);
+    }
+
+    const EloRating* average_elo_ratings() const noexcept {
+      return column<EloRating>(record_->average_elo_ratings_offset);
+    }
+
+    const double* average_victory_points_per_game() const noexcept {
+      return column<double>(record_->average_victory_points_per_game_offset);
+    }
+
+    const Percentage* effective_win_rates() const noexcept {
+      return column<Percentage>(record_->effective_win_rates_offset);
+    }
+
+    /// \brief Number of Nth place finishes at the time of each snapshot.
+    const uint32_t* place_counts(const Place place) const noexcept {
+      return column<uint32_t>(
+          record_->place_counts_offsets[static_cast<std::size_t>(
+              std::clamp(place.value(), int8_t{1}, MaximumPlace) - 1)]);
+    }
+
+    /// \brief Snapshot with a given index, reassembled from the columns.
+    Snapshot snapshot(const std::size_t index) const noexcept {
+      std::array<uint32_t, MaximumPlace> place_counts_;
+      for (int8_t place = 1; place <= MaximumPlace; ++place) {
+        place_counts_[place - 1] = place_counts({place})[index];
+      }
+      return {global_game_numbers()[index] - 1,
+              index,
+              dates()[index],
+              average_victory_points_per_game()[index],
+              place_counts_,
+              effective_win_rates()[index],
+              current_elo_ratings()[index],
+              average_elo_ratings()[index]};
+    }
+
+    /// \brief Latest snapshot. Must not be called if there are no snapshots.
+    Snapshot latest_snapshot() const noexcept {
+      return snapshot(size() - 1);
+    }
+
+  private:
+    const char* data_;
+
+    const StateFileEntity* record_;
+
+    template <typename Type>
+    const Type* column(const uint64_t offset) const noexcept {
+      return reinterpret_cast<const Type*>(data_ + offset);
+    }
+  };
+
+  /// \brief View of the players or of the factions.
+  class Entities {
+  public:
+    Entities(const char* const data, const StateFileTable& table) noexcept
+      : data_(data), table_(&table) {}
+
+    std::size_t size() const noexcept {
+      return table_->number_of_entities;
+    }
+
+    Entity operator[](const std::size_t index) const noexcept {
+      return {data_, records()[index]};
+    }
+
+    /// \brief Entity with a given name, or no value if there is none. Names
+    /// are compared byte by byte.
+    std::optional<Entity> find(const std::string_view name) const noexcept {
+      const uint64_t* const by_name{
+          reinterpret_cast<const uint64_t*>(data_ + table_->by_name_offset)};
+      const uint64_t* const found{std::lower_bound(
+          by_name, by_name + size(), name,
+          [this](const uint64_t index, const std::string_view name_) {
+            return (*this)[index].name() < name_;
+          })};
+      if (found != by_name + size() && (*this)[*found].name() == name) {
+        return {(*this)[*found]};
+      } else {
+        const std::optional<Entity> no_entity;
+        return no_entity;
+      }
+    }
+
+    /// \brief Number of entities with at least one snapshot.
+    std::size_t number_of_ranked() const noexcept {
+      return table_->number_of_ranked_entities;
+    }
+
+    /// \brief Entity at a given position, starting from 0, of the ranking by
+    /// average Elo rating in descending order.
+    Entity ranked(const std::size_t position) const noexcept {
+      return (*this)[reinterpret_cast<const uint64_t*>(
+          data_ + table_->by_rating_offset)[position]];
+    }
+
+  private:
+    const char* data_;
+
+    const StateFileTable* table_;
+
+    const StateFileEntity* records() const noexcept {
+      return reinterpret_cast<const StateFileEntity*>(
+          data_ + table_->entities_offset);
+    }
+  };
+
+  /// \brief Maps a state file into memory and checks its header and the
+  /// location of every array in it.
+  StateFile(const std::filesystem::path& path) : path_(path) {
+    const int descriptor{::open(path_.c_str(), O_RDONLY)};
+    if (descriptor < 0) {
+      error("Could not open the state file: " + path_.string());
+    }
+    struct stat status;
+    if (::fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode)
+        && static_cast<std::size_t>(status.st_size)
+               >= sizeof(StateFileHeader)) {
+      size_ = static_cast<std::size_t>(status.st_size);
+      void* const mapping{
+          ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, descriptor, 0)};
+      if (mapping != MAP_FAILED) {
+        data_ = static_cast<const char*>(mapping);
+      }
+    }
+    ::close(descriptor);
+    if (data_ == nullptr || !valid()) {
+      error("The file '" + path_.string() + "' is not a valid state file.");
+    }
+  }
+
+  StateFile(const StateFile&) = delete;
+
+  StateFile& operator=(const StateFile&) = delete;
+
+  ~StateFile() noexcept {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  const std::filesystem::path& path() const noexcept {
+    return path_;
+  }
+
+  /// \brief Number of games from which the statistics were computed.
+  std::size_t number_of_games() const noexcept {
+    return header().number_of_games;
+  }
+
+  Entities players() const noexcept {
+    return {data_, header().players};
+  }
+
+  Entities factions() const noexcept {
+    return {data_, header().factions};
+  }
+
+private:
+  std::filesystem::path path_;
+
+  const char* data_{nullptr};
+
+  std::size_t size_{0};
+
+  const StateFileHeader& header() const noexcept {
+    return *reinterpret_cast<const StateFileHeader*>(data_);
+  }
+
+  bool valid() const noexcept {
+    return header().signature == StateFileSignature
+           && header().version == StateFileVersion
+           && header().byte_order_mark == StateFileByteOrderMark
+           && header().size == size_ && valid(header().players)
+           && valid(header().factions);
+  }
+
+  bool valid(const StateFileTable& table) const noexcept {
+    if (!within(table.entities_offset, table.number_of_entities,
+                sizeof(StateFileEntity))
+        || !within(table.by_name_offset, table.number_of_entities,
+                   sizeof(uint64_t))
+        || table.number_of_ranked_entities > table.number_of_entities
+        || !within(table.by_rating_offset, table.number_of_ranked_entities,
+                   sizeof(uint64_t))) {
+      return false;
+    }
+    const StateFileEntity* const records{
+        reinterpret_cast<const StateFileEntity*>(
+            data_ + table.entities_offset)};
+    for (uint64_t index = 0; index < table.number_of_entities; ++index) {
+      if (!valid(records[index])) {
+        return false;
+      }
+    }
+    const uint64_t* const by_name{
+        reinterpret_cast<const uint64_t*>(data_ + table.by_name_offset)};
+    const uint64_t* const by_rating{
+        reinterpret_cast<const uint64_t*>(data_ + table.by_rating_offset)};
+    return std::all_of(by_name, by_name + table.number_of_entities,
+                       [&table](const uint64_t index) {
+                         return index < table.number_of_entities;
+                       })
+           && std::all_of(by_rating,
+                          by_rating + table.number_of_ranked_entities,
+                          [records, &table](const uint64_t index) {
+                            return index < table.number_of_entities
+                                   && records[index].number_of_snapshots > 0;
+                          });
+  }
+
+  bool valid(const StateFileEntity& record) const noexcept {
+    const uint64_t size{record.number_of_snapshots};
+    bool valid_{
+        within(record.name_offset, record.name_size, 1, 1)
+        && within(record.global_game_numbers_offset, size, sizeof(std::size_t))
+        && within(record.dates_offset, size, sizeof(Date))
+        && within(record.current_elo_ratings_offset, size, sizeof(EloRating))
+        && within(record.average_elo_ratings_offset, size, sizeof(EloRating))
+        && within(record.average_victory_points_per_game_offset, size,
+                  sizeof(double))
+        && within(record.effective_win_rates_offset, size, sizeof(Percentage))};
+    for (const uint64_t offset : record.place_counts_offsets) {
+      valid_ = valid_ && within(offset, size, sizeof(uint32_t));
+    }
+    return valid_;
+  }
+
+  /// \brief Whether an array of a given number of elements of a given size
+  /// lies within the file, starting at a given offset with a given alignment.
+  bool within(const uint64_t offset, const uint64_t number_of_elements,
+              const uint64_t element_size,
+              const uint64_t alignment = StateFileAlignment) const noexcept {
+    return offset % alignment == 0 && offset <= size_
+           && number_of_elements <= (size_ - offset) / element_size;
+  }
+
+};  // class StateFile
+
+}  // namespace TI4Echelon
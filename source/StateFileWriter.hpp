@@ -0,0 +1,169 @@
+#pragma once
+
+#include "BinaryFileWriter.hpp"
+#include "Factions.hpp"
+#include "Players.hpp"
+#include "StateFile.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Writes the player and faction statistics computed from all games to
+/// a state file, which queries can then map into memory and read directly. See
+/// StateFile for the layout of the file. The file is replaced atomically.
+class StateFileWriter : public BinaryFileWriter {
+public:
+  StateFileWriter(const std::filesystem::path& path, const Games& games,
+                  const Players& players, const Factions& factions)
+    : BinaryFileWriter(path) {
+    static_assert(std::is_trivially_copyable<Date>::value
+                      && std::is_trivially_copyable<EloRating>::value
+                      && std::is_trivially_copyable<Percentage>::value,
+                  "The snapshot columns must be trivially copyable.");
+    if (path_.empty()) {
+      return;
+    }
+    const ProfilerScope profiler_scope{"Write the state file"};
+    replace_atomically_ = true;
+    StateFileHeader header;
+    header.signature = StateFileSignature;
+    header.version = StateFileVersion;
+    header.byte_order_mark = StateFileByteOrderMark;
+    header.number_of_games = games.size();
+    reserve(sizeof(StateFileHeader));
+    header.players = table(players);
+    header.factions = table(factions);
+    header.size = content_.size();
+    overwrite(0, &header, sizeof(StateFileHeader));
+    write();
+    message("Wrote the state file '" + path.string() + "'.");
+  }
+
+private:
+  static std::string name(const Player& player) noexcept {
+    return player.name().value();
+  }
+
+  static std::string name(const Faction& faction) noexcept {
+    return label(faction.name());
+  }
+
+  /// \brief Writes the records, indices, names, and snapshot histories of the
+  /// players or factions, and returns their location.
+  template <typename Entities>
+  StateFileTable table(const Entities& entities) noexcept {
+    StateFileTable table_;
+    table_.number_of_entities = entities.size();
+    table_.entities_offset =
+        reserve(entities.size() * sizeof(StateFileEntity));
+    std::vector<StateFileEntity> records;
+    std::vector<std::string> names;
+    for (const auto& entity : entities) {
+      names.push_back(name(entity));
+      records.push_back(record(names.back(), entity.snapshots()));
+    }
+    overwrite(table_.entities_offset, records.data(),
+              records.size() * sizeof(StateFileEntity));
+    std::vector<uint64_t> by_name(entities.size());
+    std::iota(by_name.begin(), by_name.end(), 0);
+    std::sort(by_name.begin(), by_name.end(),
+              [&names](const uint64_t index_1, const uint64_t index_2) {
+                return names[index_1] < names[index_2];
+              });
+    table_.by_name_offset = array(by_name);
+    // Rank the entities in the same way as the leaderboard.
+    std::vector<uint64_t> by_rating;
+    for (uint64_t index = 0; index < records.size(); ++index) {
+      if (records[index].number_of_snapshots > 0) {
+        by_rating.push_back(index);
+      }
+    }
+    std::vector<EloRating> average_elo_ratings;
+    for (const auto& entity : entities) {
+      average_elo_ratings.push_back(
+          entity.latest_snapshot() != nullptr ?
+              entity.latest_snapshot()->average_elo_rating() :
+              EloRating{});
+    }
+    std::stable_sort(
+        by_rating.begin(), by_rating.end(),
+        [&average_elo_ratings](const uint64_t index_1, const uint64_t index_2) {
+          return average_elo_ratings[index_1] > average_elo_ratings[index_2];
+        });
+    table_.number_of_ranked_entities = by_rating.size();
+    table_.by_rating_offset = array(by_rating);
+    return table_;
+  }
+
+  /// \brief Writes the name and snapshot history of a player or faction, and
+  /// returns their location.
+  StateFileEntity record(const std::string& name_,
+                         const SnapshotHistory& snapshots) noexcept {
+    StateFileEntity record_;
+    record_.name_offset = align();
+    record_.name_size = name_.size();
+    content_ += name_;
+    record_.number_of_snapshots = snapshots.size();
+    record_.global_game_numbers_offset = array(snapshots.global_game_numbers());
+    record_.dates_offset = dates(snapshots.dates());
+    record_.current_elo_ratings_offset = array(snapshots.current_elo_ratings());
+    record_.average_elo_ratings_offset = array(snapshots.average_elo_ratings());
+    record_.average_victory_points_per_game_offset =
+        array(snapshots.average_victory_points_per_game());
+    record_.effective_win_rates_offset = array(snapshots.effective_win_rates());
+    for (int8_t place = 1; place <= MaximumPlace; ++place) {
+      record_.place_counts_offsets[place - 1] =
+          array(snapshots.place_counts({place}));
+    }
+    return record_;
+  }
+
+  /// \brief Writes the values of a vector as they are laid out in memory, and
+  /// returns their offset.
+  template <typename Type>
+  uint64_t array(const std::vector<Type>& values) noexcept {
+    const uint64_t offset{align()};
+    content_.append(reinterpret_cast<const char*>(values.data()),
+                    values.size() * sizeof(Type));
+    return offset;
+  }
+
+  /// \brief Writes dates as they are laid out in memory, and returns their
+  /// offset. Each date is constructed in zeroed memory such that its padding
+  /// bytes are written as zeros.
+  uint64_t dates(const std::vector<Date>& values) noexcept {
+    const uint64_t offset{align()};
+    for (const Date& date : values) {
+      alignas(Date) char bytes[sizeof(Date)]{};
+      new (bytes) Date{static_cast<int16_t>(date.year()), date.month_number(),
+                       date.day_number()};
+      content_.append(bytes, sizeof(Date));
+    }
+    return offset;
+  }
+
+  /// \brief Pads the content with zeros to the next multiple of the alignment,
+  /// and returns the size of the content.
+  uint64_t align() noexcept {
+    content_.resize(
+        (content_.size() + StateFileAlignment - 1) / StateFileAlignment
+            * StateFileAlignment,
+        '\0');
+    return content_.size();
+  }
+
+  /// \brief Appends a number of zeros, to be overwritten later, and returns
+  /// their offset.
+  uint64_t reserve(const std::size_t size) noexcept {
+    const uint64_t offset{align()};
+    content_.resize(offset + size, '\0');
+    return offset;
+  }
+
+  void overwrite(const uint64_t offset, const void* const data,
+                 const std::size_t size) noexcept {
+    std::memcpy(content_.data() + offset, data, size);
+  }
+
+};  // class StateFileWriter
+
+}  // namespace TI4Echelon
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Echelon {
+
+/// \brief Sequence of up to a fixed number of elements stored inline, without
+/// any heap allocation. Used for small per-game collections.
+template <typename Type, std::size_t Capacity>
+class StaticVector {
+public:
+  /// \brief Default constructor. Initializes an empty sequence.
+  constexpr StaticVector() noexcept {}
+
+  using const_iterator = typename std::array<Type, Capacity>::const_iterator;
+
+  constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+
+  static constexpr std::size_t capacity() noexcept {
+    return Capacity;
+  }
+
+  constexpr const Type& operator[](const std::size_t index) const noexcept {
+    return data_[index];
+  }
+
+  constexpr const Type& back() const noexcept {
+    return data_[size_ - 1];
+  }
+
+  constexpr const_iterator begin() const noexcept {
+    return const_iterator(data_.cbegin());
+  }
+
+  constexpr const_iterator cbegin() const noexcept {
+    return const_iterator(data_.cbegin());
+  }
+
+  constexpr const_iterator end() const noexcept {
+    return const_iterator(data_.cbegin() + size_);
+  }
+
+  constexpr const_iterator cend() const noexcept {
+    return const_iterator(data_.cbegin() + size_);
+  }
+
+  bool contains(const Type& value) const noexcept {
+    return std::find(cbegin(), cend(), value) != cend();
+  }
+
+  /// \brief Appends an element. The sequence must not already be full.
+  void push_back(const Type& value) {
+    if (size_ >= Capacity) {
+      error("Cannot store more than " + std::to_string(Capacity)
+            + " elements.");
+    }
+    data_[size_] = value;
+    ++size_;
+  }
+
+  /// \brief Inserts an element before the element at a given index, shifting
+  /// the subsequent elements. The sequence must not already be full.
+  void insert(const std::size_t index, const Type& value) {
+    if (size_ >= Capacity) {
+      error("Cannot store more than " + std::to_string(Capacity)
+            + " elements.");
+    }
+    std::move_backward(data_.begin() + index, data_.begin() + size_,
+                       data_.begin() + size_ + 1);
+    data_[index] = value;
+    ++size_;
+  }
+
+  /// \brief Sorts the elements using a given comparison.
+  template <typename Compare>
+  void sort(const Compare compare) noexcept {
+    std::sort(data_.begin(), data_.begin() + size_, compare);
+  }
+
+private:
+  std::array<Type, Capacity> data_{};
+
+  std::size_t size_{0};
+
+};  // class StaticVector
+
+}  // namespace TI4Echelon
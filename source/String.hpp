@@ -12,6 +12,27 @@ std::vector<std::string> split_by_whitespace(const std::string& text) noexcept {
   return words;
 }
 
+/// \brief Split a string view into words using whitespace as a delimiter. The
+/// words are views into the same text and are not copied.
+std::vector<std::string_view> split_by_whitespace(
+    const std::string_view text) noexcept {
+  std::vector<std::string_view> words;
+  std::size_t index{0};
+  while (index < text.size()) {
+    while (index < text.size() && ::isspace(text[index])) {
+      ++index;
+    }
+    const std::size_t start{index};
+    while (index < text.size() && !::isspace(text[index])) {
+      ++index;
+    }
+    if (index > start) {
+      words.push_back(text.substr(start, index - start));
+    }
+  }
+  return words;
+}
+
 /// \brief Split a string into lines using newlines as a delimiter.
 std::vector<std::string> split_by_newline(const std::string& text) noexcept {
   std::stringstream stream(text);
@@ -147,6 +168,30 @@ std::string real_number_to_string(
   return stream.str();
 }
 
+/// \brief Append an integer number to a string.
+template <typename Integer>
+void append_integer_number(std::string& output, const Integer value) noexcept {
+  char buffer[24];
+  const std::to_chars_result result{
+      std::to_chars(buffer, buffer + sizeof(buffer), value)};
+  output.append(buffer, result.ptr);
+}
+
+/// \brief Append a real number to a string to a given number of decimals.
+/// Gives the same text as real_number_to_string().
+void append_real_number(std::string& output, const double value,
+                        const int8_t decimals = 2) noexcept {
+  char buffer[64];
+  const std::to_chars_result result{
+      std::to_chars(buffer, buffer + sizeof(buffer), value,
+                    std::chars_format::fixed, decimals)};
+  if (result.ec == std::errc{}) {
+    output.append(buffer, result.ptr);
+  } else {
+    output += real_number_to_string(value, decimals);
+  }
+}
+
 /// \brief Parse a string as an integer number.
 std::optional<int64_t> string_to_integer_number(
     const std::string& text) noexcept {
@@ -171,6 +216,17 @@ std::optional<double> string_to_real_number(const std::string& text) noexcept {
   return no_value;
 }
 
+/// \brief 64-bit FNV-1a hash of a text. A text split into several parts can be
+/// hashed by passing the hash of the preceding parts as the initial hash.
+uint64_t content_hash(const std::string_view text,
+                      uint64_t hash = 14695981039346656037ULL) noexcept {
+  for (const char character : text) {
+    hash ^= static_cast<uint8_t>(character);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 std::string markdown_boldface(const std::string& text) noexcept {
   return "**" + text + "**";
 }
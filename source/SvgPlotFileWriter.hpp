@@ -0,0 +1,323 @@
+#pragma once
+
+#include "Path.hpp"
+#include "Plot.hpp"
+#include "TextFileWriter.hpp"
+
+namespace TI4Echelon {
+
+/// \brief File writer that renders a plot directly as a scalable vector
+/// graphics image (.svg), without any external program.
+/// \details The layout follows that of the Gnuplot plots: a light gray
+/// background, a horizontal key above the plot area, a dotted grid at the major
+/// and minor tics, and the vertical axis tics mirrored on the right side.
+class SvgPlotFileWriter : public TextFileWriter {
+public:
+  /// \brief Constructor. Takes a file stem, i.e. a file path without a file
+  /// extension. The file extension is appended automatically.
+  SvgPlotFileWriter(const std::filesystem::path& stem, const Plot& plot)
+    : TextFileWriter(file_name(stem, Path::SvgPlotImageFileExtension)),
+      plot_(plot) {
+    initialize_key();
+    line("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\""
+         + std::to_string(PlotWidthPixels) + "\" height=\""
+         + std::to_string(PlotHeightPixels) + "\" viewBox=\"0 0 "
+         + std::to_string(PlotWidthPixels) + " "
+         + std::to_string(PlotHeightPixels)
+         + "\" font-family=\"Verdana, sans-serif\" font-size=\"12\">");
+    line("<rect width=\"100%\" height=\"100%\" fill=\"#"
+         + color_code(Color::LightGray) + "\"/>");
+    grid();
+    tics();
+    axis_labels();
+    series();
+    line("<rect x=\"" + coordinate(left_) + "\" y=\"" + coordinate(top_)
+         + "\" width=\"" + coordinate(right_ - left_) + "\" height=\""
+         + coordinate(bottom_ - top_)
+         + "\" fill=\"none\" stroke=\"#000000\"/>");
+    key();
+    line("</svg>");
+    write();
+  }
+
+private:
+  static constexpr const double key_row_height_{16.0};
+
+  static constexpr const double key_sample_width_{24.0};
+
+  /// \brief Approximate width of a character of the key text.
+  static constexpr const double character_width_{7.0};
+
+  static constexpr const double major_tic_length_{6.0};
+
+  static constexpr const double minor_tic_length_{3.0};
+
+  const Plot& plot_;
+
+  double left_{70.0};
+
+  double right_{PlotWidthPixels - 60.0};
+
+  double top_{20.0};
+
+  double bottom_{PlotHeightPixels - 50.0};
+
+  double key_entry_width_{0.0};
+
+  std::size_t key_columns_{1};
+
+  std::vector<const PlotSeries*> key_entries_;
+
+  /// \brief Lays out the key in rows of equally wide entries and makes room
+  /// for it above the plot area.
+  void initialize_key() noexcept {
+    std::size_t longest_title{0};
+    for (const PlotSeries& one_series : plot_.series) {
+      if (!one_series.title.empty()) {
+        key_entries_.push_back(&one_series);
+        longest_title = std::max(longest_title, one_series.title.size());
+      }
+    }
+    if (!key_entries_.empty()) {
+      key_entry_width_ =
+          key_sample_width_ + 20.0
+          + character_width_ * static_cast<double>(longest_title);
+      key_columns_ = std::clamp(
+          static_cast<std::size_t>((PlotWidthPixels - 20.0) / key_entry_width_),
+          static_cast<std::size_t>(1), key_entries_.size());
+      const std::size_t key_rows{
+          (key_entries_.size() + key_columns_ - 1) / key_columns_};
+      top_ = 20.0 + key_row_height_ * static_cast<double>(key_rows);
+    }
+  }
+
+  double x(const double value) const noexcept {
+    return left_
+           + (value - plot_.x_axis.minimum)
+                 / (plot_.x_axis.maximum - plot_.x_axis.minimum)
+                 * (right_ - left_);
+  }
+
+  double y(const double value) const noexcept {
+    return bottom_
+           - (value - plot_.y_axis.minimum)
+                 / (plot_.y_axis.maximum - plot_.y_axis.minimum)
+                 * (bottom_ - top_);
+  }
+
+  /// \brief Values of the tics of an axis spaced by a given increment.
+  static std::vector<double> tic_values(
+      const PlotAxis& axis, const double increment) noexcept {
+    std::vector<double> values;
+    if (increment > 0.0) {
+      const int64_t first{
+          static_cast<int64_t>(std::ceil(axis.minimum / increment - 1.0e-9))};
+      const int64_t last{
+          static_cast<int64_t>(std::floor(axis.maximum / increment + 1.0e-9))};
+      for (int64_t index = first; index <= last; ++index) {
+        values.push_back(static_cast<double>(index) * increment);
+      }
+    }
+    return values;
+  }
+
+  static std::vector<double> major_tic_values(const PlotAxis& axis) noexcept {
+    return tic_values(axis, axis.increment);
+  }
+
+  /// \brief Values of all tics of an axis, including the major tics.
+  static std::vector<double> minor_tic_values(const PlotAxis& axis) noexcept {
+    return tic_values(
+        axis, axis.increment
+                  / static_cast<double>(std::max(
+                      axis.minor_intervals, static_cast<int64_t>(1))));
+  }
+
+  void grid() noexcept {
+    std::string text{"<g stroke=\"#" + color_code(Color::DarkGray)
+                     + "\" stroke-width=\"0.5\" stroke-dasharray=\"1,3\">"};
+    for (const double value : minor_tic_values(plot_.x_axis)) {
+      text += segment(x(value), top_, x(value), bottom_);
+    }
+    for (const double value : minor_tic_values(plot_.y_axis)) {
+      text += segment(left_, y(value), right_, y(value));
+    }
+    line(text + "</g>");
+  }
+
+  void tics() noexcept {
+    std::string text{"<g stroke=\"#000000\">"};
+    for (const double value : minor_tic_values(plot_.x_axis)) {
+      text += segment(x(value), bottom_, x(value), bottom_ + minor_tic_length_);
+    }
+    for (const double value : major_tic_values(plot_.x_axis)) {
+      text += segment(x(value), bottom_, x(value), bottom_ + major_tic_length_);
+    }
+    for (const double value : minor_tic_values(plot_.y_axis)) {
+      text += segment(left_ - minor_tic_length_, y(value), left_, y(value))
+              + segment(right_ - minor_tic_length_, y(value), right_, y(value));
+    }
+    for (const double value : major_tic_values(plot_.y_axis)) {
+      text += segment(left_ - major_tic_length_, y(value), left_, y(value))
+              + segment(right_ - major_tic_length_, y(value), right_, y(value));
+    }
+    line(text + "</g>");
+    text = "<g text-anchor=\"middle\">";
+    for (const double value : major_tic_values(plot_.x_axis)) {
+      text += "<text x=\"" + coordinate(x(value)) + "\" y=\""
+              + coordinate(bottom_ + 20.0) + "\">"
+              + tic_label(value, plot_.x_axis.increment) + "</text>";
+    }
+    line(text + "</g>");
+    text = "<g text-anchor=\"end\">";
+    for (const double value : major_tic_values(plot_.y_axis)) {
+      text += "<text x=\"" + coordinate(left_ - 9.0) + "\" y=\""
+              + coordinate(y(value) + 4.0) + "\">"
+              + tic_label(value, plot_.y_axis.increment) + "</text>";
+    }
+    line(text + "</g>");
+    text = "<g text-anchor=\"start\">";
+    for (const double value : major_tic_values(plot_.y_axis)) {
+      text += "<text x=\"" + coordinate(right_ + 6.0) + "\" y=\""
+              + coordinate(y(value) + 4.0) + "\">"
+              + tic_label(value, plot_.y_axis.increment) + "</text>";
+    }
+    line(text + "</g>");
+  }
+
+  void axis_labels() noexcept {
+    line("<text x=\"" + coordinate((left_ + right_) / 2.0) + "\" y=\""
+         + coordinate(PlotHeightPixels - 12.0) + "\" text-anchor=\"middle\">"
+         + escape(plot_.x_axis.label) + "</text>");
+    line("<text transform=\"translate(18,"
+         + coordinate((top_ + bottom_) / 2.0)
+         + ") rotate(-90)\" text-anchor=\"middle\">"
+         + escape(plot_.y_axis.label) + "</text>");
+  }
+
+  void series() noexcept {
+    line("<clipPath id=\"plot-area\"><rect x=\"" + coordinate(left_)
+         + "\" y=\"" + coordinate(top_) + "\" width=\""
+         + coordinate(right_ - left_) + "\" height=\""
+         + coordinate(bottom_ - top_) + "\"/></clipPath>");
+    line("<g clip-path=\"url(#plot-area)\">");
+    for (const PlotSeries& one_series : plot_.series) {
+      if (one_series.markers) {
+        markers(one_series);
+      } else {
+        polyline(one_series);
+      }
+    }
+    line("</g>");
+  }
+
+  /// \brief Draws a series as a line through its points. Consecutive points
+  /// that fall on the same rendered coordinates are drawn only once.
+  void polyline(const PlotSeries& one_series) noexcept {
+    std::string points;
+    std::string previous;
+    for (const std::pair<double, double>& point : one_series.points) {
+      std::string current{
+          coordinate(x(point.first)) + "," + coordinate(y(point.second))};
+      if (current != previous) {
+        points += (points.empty() ? "" : " ") + current;
+        previous = std::move(current);
+      }
+    }
+    line("<polyline fill=\"none\" stroke=\"#" + color_code(one_series.color)
+         + "\" stroke-width=\"2\" stroke-linejoin=\"round\" points=\"" + points
+         + "\"/>");
+  }
+
+  void markers(const PlotSeries& one_series) noexcept {
+    std::string text{"<g fill=\"#" + color_code(one_series.color) + "\">"};
+    for (const std::pair<double, double>& point : one_series.points) {
+      text += "<circle cx=\"" + coordinate(x(point.first)) + "\" cy=\""
+              + coordinate(y(point.second)) + "\" r=\"3\"/>";
+    }
+    line(text + "</g>");
+  }
+
+  void key() noexcept {
+    const std::size_t columns{std::min(key_columns_, key_entries_.size())};
+    const double start{
+        (PlotWidthPixels - key_entry_width_ * static_cast<double>(columns))
+        / 2.0};
+    for (std::size_t index = 0; index < key_entries_.size(); ++index) {
+      const PlotSeries& one_series{*key_entries_[index]};
+      const double entry_x{
+          start
+          + key_entry_width_ * static_cast<double>(index % key_columns_)};
+      const double entry_y{
+          12.0
+          + key_row_height_ * static_cast<double>(index / key_columns_)};
+      if (one_series.markers) {
+        line("<circle cx=\"" + coordinate(entry_x + key_sample_width_ / 2.0)
+             + "\" cy=\"" + coordinate(entry_y) + "\" r=\"3\" fill=\"#"
+             + color_code(one_series.color) + "\"/>");
+      } else {
+        line("<line x1=\"" + coordinate(entry_x) + "\" y1=\""
+             + coordinate(entry_y) + "\" x2=\""
+             + coordinate(entry_x + key_sample_width_) + "\" y2=\""
+             + coordinate(entry_y) + "\" stroke=\"#"
+             + color_code(one_series.color) + "\" stroke-width=\"2\"/>");
+      }
+      line("<text x=\"" + coordinate(entry_x + key_sample_width_ + 6.0)
+           + "\" y=\"" + coordinate(entry_y + 4.0) + "\">"
+           + escape(one_series.title) + "</text>");
+    }
+  }
+
+  static std::string segment(const double x1, const double y1, const double x2,
+                             const double y2) noexcept {
+    return "<line x1=\"" + coordinate(x1) + "\" y1=\"" + coordinate(y1)
+           + "\" x2=\"" + coordinate(x2) + "\" y2=\"" + coordinate(y2)
+           + "\"/>";
+  }
+
+  static std::string coordinate(const double value) noexcept {
+    return real_number_to_string(value, 1);
+  }
+
+  /// \brief Label of a tic, printed with as many decimals as the tic increment
+  /// needs.
+  static std::string tic_label(
+      const double value, const double increment) noexcept {
+    int8_t decimals{0};
+    double scaled{increment};
+    while (decimals < 6 && std::abs(scaled - std::round(scaled)) > 1.0e-9) {
+      scaled *= 10.0;
+      ++decimals;
+    }
+    return real_number_to_string(value, decimals);
+  }
+
+  /// \brief Escapes the characters of a text that have a special meaning in
+  /// XML.
+  static std::string escape(const std::string& text) noexcept {
+    std::string escaped;
+    for (const char character : text) {
+      switch (character) {
+        case '&':
+          escaped += "&amp;";
+          break;
+        case '<':
+          escaped += "&lt;";
+          break;
+        case '>':
+          escaped += "&gt;";
+          break;
+        case '"':
+          escaped += "&quot;";
+          break;
+        default:
+          escaped += character;
+          break;
+      }
+    }
+    return escaped;
+  }
+
+};  // class SvgPlotFileWriter
+
+}  // namespace TI4Echelon
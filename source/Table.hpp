@@ -13,24 +13,39 @@ public:
   Table() noexcept {}
 
   std::string print_as_data() const noexcept {
-    std::stringstream stream;
-    stream << print_data_header();
+    std::string text;
+    print_as_data(text);
+    return text;
+  }
+
+  /// \brief Appends the table in the Data (.dat) format to an output buffer,
+  /// one row at a time, without a trailing newline.
+  void print_as_data(std::string& output) const noexcept {
+    print_data_header(output);
     const std::size_t number_of_rows_{number_of_rows()};
     for (std::size_t row_index = 0; row_index < number_of_rows_; ++row_index) {
-      stream << std::endl << print_data_row(row_index);
+      output += '\n';
+      print_data_row(output, row_index);
     }
-    return stream.str();
   }
 
   std::string print_as_markdown() const noexcept {
-    std::stringstream stream;
-    stream << print_markdown_header();
-    stream << std::endl << print_markdown_alignment();
+    std::string text;
+    print_as_markdown(text);
+    return text;
+  }
+
+  /// \brief Appends the table in the Markdown (.md) format to an output
+  /// buffer, one row at a time, without a trailing newline.
+  void print_as_markdown(std::string& output) const noexcept {
+    print_markdown_header(output);
+    output += '\n';
+    print_markdown_alignment(output);
     const std::size_t number_of_rows_{number_of_rows()};
     for (std::size_t row_index = 0; row_index < number_of_rows_; ++row_index) {
-      stream << std::endl << print_markdown_row(row_index);
+      output += '\n';
+      print_markdown_row(output, row_index);
     }
-    return stream.str();
   }
 
   struct iterator : public std::vector<TableColumn>::iterator {
@@ -123,58 +138,62 @@ public:
 protected:
   std::vector<TableColumn> columns_;
 
-  std::string print_data_header() const noexcept {
-    std::string text{"#"};
+  void print_data_header(std::string& output) const noexcept {
+    output += '#';
+    const std::size_t start{output.size()};
     for (const TableColumn& column : columns_) {
-      if (text.size() > 1) {
-        text += " ";
+      if (output.size() > start) {
+        output += ' ';
       }
-      text += column.header();
+      output += column.header();
     }
-    return text;
   }
 
-  std::string print_markdown_header() const noexcept {
-    std::string text{"|"};
+  void print_markdown_header(std::string& output) const noexcept {
+    output += '|';
     for (const TableColumn& column : columns_) {
-      text += " " + markdown_boldface(column.header()) + " |";
+      output += ' ';
+      output += markdown_boldface(column.header());
+      output += " |";
     }
-    return text;
   }
 
-  std::string print_markdown_alignment() const noexcept {
-    std::string text{"|"};
+  void print_markdown_alignment(std::string& output) const noexcept {
+    output += '|';
     for (const TableColumn& column : columns_) {
-      text += " " + markdown(column.alignment()) + " |";
+      output += ' ';
+      output += markdown(column.alignment());
+      output += " |";
     }
-    return text;
   }
 
-  std::string print_data_row(const std::size_t index) const noexcept {
-    std::string text;
+  void print_data_row(
+      std::string& output, const std::size_t index) const noexcept {
+    const std::size_t start{output.size()};
     for (const TableColumn& column : columns_) {
       if (index < column.number_of_rows()) {
-        if (!text.empty()) {
-          text += " ";
+        if (output.size() > start) {
+          output += ' ';
         }
-        text += column.row(index).print();
+        column.row(index).print(output);
       } else {
-        text += " ";
+        output += ' ';
       }
     }
-    return text;
   }
 
-  std::string print_markdown_row(const std::size_t index) const noexcept {
-    std::string text{"|"};
+  void print_markdown_row(
+      std::string& output, const std::size_t index) const noexcept {
+    output += '|';
     for (const TableColumn& column : columns_) {
       if (index < column.number_of_rows()) {
-        text += " " + column.row(index).print() + " |";
+        output += ' ';
+        column.row(index).print(output);
+        output += " |";
       } else {
-        text += "  |";
+        output += "  |";
       }
     }
-    return text;
   }
 
 };  // class Table
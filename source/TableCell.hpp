@@ -5,47 +5,110 @@
 
 namespace TI4Echelon {
 
-/// \brief Cell in a table.
+/// \brief Cell in a table. The cell stores its typed value and only formats it
+/// as text when the table is printed, directly into the output buffer.
 class TableCell {
 public:
   TableCell() noexcept {}
 
   TableCell(const std::size_t number) noexcept
-    : value_(std::to_string(number)) {}
+    : value_(static_cast<uint64_t>(number)) {}
 
   TableCell(const double number, const int8_t decimals = 2) noexcept
-    : value_(real_number_to_string(number, decimals)) {}
+    : value_(RealNumber{number, decimals}) {}
 
   TableCell(const std::string& text) noexcept : value_(text) {}
 
-  TableCell(const Date& date) noexcept : value_(date.print()) {}
+  TableCell(const Date& date) noexcept : value_(date) {}
 
-  TableCell(const EloRating& elo_rating) noexcept
-    : value_(elo_rating.print()) {}
+  TableCell(const EloRating& elo_rating) noexcept : value_(elo_rating) {}
 
-  TableCell(const FactionName faction_name) noexcept
-    : value_(label(faction_name)) {}
+  TableCell(const FactionName faction_name) noexcept : value_(faction_name) {}
 
-  TableCell(const GameMode game_mode) noexcept : value_(label(game_mode)) {}
+  TableCell(const GameMode game_mode) noexcept : value_(game_mode) {}
 
-  TableCell(const Percentage& percentage) noexcept
-    : value_(percentage.print()) {}
+  TableCell(const Percentage& percentage) noexcept : value_(percentage) {}
 
-  TableCell(const Place& place) noexcept : value_(place.print()) {}
+  TableCell(const Place& place) noexcept : value_(place) {}
 
-  TableCell(const PlayerName& player_name) noexcept
-    : value_(player_name.value()) {}
+  TableCell(const PlayerName& player_name) noexcept : value_(player_name) {}
 
   TableCell(const VictoryPoints& victory_points) noexcept
-    : value_(victory_points.print()) {}
+    : value_(victory_points) {}
 
-  const std::string& print() const noexcept {
-    return value_;
+  std::string print() const noexcept {
+    std::string text;
+    print(text);
+    return text;
+  }
+
+  /// \brief Appends the text of this cell to an output buffer.
+  void print(std::string& output) const noexcept {
+    std::visit([&output](const auto& value) { append(output, value); },
+               value_);
   }
 
 protected:
-  std::string value_;
+  /// \brief Real number printed to a given number of decimals.
+  struct RealNumber {
+    double value{0.0};
+
+    int8_t decimals{2};
+  };
+
+  std::variant<std::string, uint64_t, RealNumber, Date, EloRating, FactionName,
+               GameMode, Percentage, Place, PlayerName, VictoryPoints>
+      value_;
+
+  static void append(std::string& output, const std::string& text) noexcept {
+    output += text;
+  }
+
+  static void append(std::string& output, const uint64_t number) noexcept {
+    append_integer_number(output, number);
+  }
+
+  static void append(std::string& output, const RealNumber& number) noexcept {
+    append_real_number(output, number.value, number.decimals);
+  }
+
+  static void append(std::string& output, const Date& date) noexcept {
+    date.print(output);
+  }
+
+  static void append(
+      std::string& output, const EloRating& elo_rating) noexcept {
+    elo_rating.print(output);
+  }
+
+  static void append(
+      std::string& output, const FactionName faction_name) noexcept {
+    output += label(faction_name);
+  }
+
+  static void append(std::string& output, const GameMode game_mode) noexcept {
+    output += label(game_mode);
+  }
+
+  static void append(
+      std::string& output, const Percentage& percentage) noexcept {
+    percentage.print(output);
+  }
+
+  static void append(std::string& output, const Place& place) noexcept {
+    output += place.print();
+  }
+
+  static void append(
+      std::string& output, const PlayerName& player_name) noexcept {
+    output += player_name.value();
+  }
+
+  static void append(
+      std::string& output, const VictoryPoints& victory_points) noexcept {
+    append_integer_number(output, victory_points.value());
+  }
 
-};  // class TableRow
+};  // class TableCell
 
 }  // namespace TI4Echelon
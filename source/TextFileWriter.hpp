@@ -16,8 +16,9 @@ protected:
     : FileWriter(path, permissions) {}
 
   void line(const std::string& text) noexcept {
-    if (stream_.is_open()) {
-      stream_ << text << std::endl;
+    if (!path_.empty()) {
+      content_ += text;
+      content_ += '\n';
     }
   }
 
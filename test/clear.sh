@@ -1,4 +1,4 @@
 #!/bin/sh
 set -e
 cd "${0%/*}"
-rm -rf leaderboard*
+rm -rf leaderboard* output